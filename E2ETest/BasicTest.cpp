@@ -1,3 +1,5 @@
+#include <set>
+
 #include <gtest/gtest.h>
 
 #include <propertytree/Client.hpp>
@@ -98,6 +100,45 @@ TEST_F(BasicTest, shouldSubscribeUpdateAndUnsubscribe)
     EXPECT_EQ(child1.value<int>(), 43);
 }
 
+TEST_F(BasicTest, shouldGetValueOnSubscribe)
+{
+    Client sut2 = Client(config);
+    auto child1 = sut2.root().get("child1");
+    ASSERT_TRUE(child1);
+    child1.subscribe();
+    EXPECT_EQ(child1.value<int>(), 44);
+    EXPECT_NE(child1.version(), 0u);
+    child1.unsubscribe();
+}
+
+TEST_F(BasicTest, shouldBulkSubscribeUpdateAndUnsubscribe)
+{
+    Client sut2 = Client(config);
+    auto root = sut2.root();
+    std::vector<Property> props = {root.get("child1"), root.get("child2")};
+
+    auto subscribed = sut2.subscribe(props);
+    ASSERT_EQ(2u, subscribed.size());
+    EXPECT_TRUE(subscribed[0]);
+    EXPECT_TRUE(subscribed[1]);
+    EXPECT_EQ(props[0].value<int>(), 44);
+    EXPECT_EQ(props[1].value<int>(), 44);
+
+    {
+        auto child1 = sut.root().get("child1");
+        child1 = 45;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(props[0].value<int>(), 45);
+
+    auto unsubscribed = sut2.unsubscribe(props);
+    ASSERT_EQ(2u, unsubscribed.size());
+    EXPECT_TRUE(unsubscribed[0]);
+    EXPECT_TRUE(unsubscribed[1]);
+}
+
 TEST_F(BasicTest, shouldRetrieveTree)
 {
     auto root = sut.root();
@@ -202,6 +243,418 @@ TEST_F(BasicTest, shouldRpcCall)
     }
 }
 
+TEST_F(BasicTest, shouldRejectRpcCallOnTimeout)
+{
+    if (auto rpc = sut.root().get("slowRpc"))
+    {
+        rpc.destroy();
+    }
+
+    auto rpc = sut.root().create("slowRpc");
+    rpc.setHRcpHandler([](const bfc::BufferView&) -> std::vector<uint8_t> {
+            std::this_thread::sleep_for(std::chrono::milliseconds(800));
+            return std::vector<uint8_t>(4);
+        });
+    {
+        // Note: The server rejects the call after its 400ms rpcTimeout, long before the caller gives up.
+        auto callerConfig = config;
+        callerConfig.transactionTimeout = std::chrono::milliseconds(2000);
+        Client sut2 = Client(callerConfig);
+        auto rpc = sut2.root().get("slowRpc");
+        uint32_t param = 42;
+        auto valueRaw = rpc.call(bfc::BufferView((std::byte*)&param, 4));
+        EXPECT_TRUE(valueRaw.empty());
+    }
+    rpc.destroy();
+}
+
+TEST_F(BasicTest, shouldRejectRpcCallToOrphanedNode)
+{
+    if (auto rpc = sut.root().get("orphanRpc"))
+    {
+        rpc.destroy();
+    }
+
+    {
+        Client sut2 = Client(config);
+        auto rpc = sut2.root().create("orphanRpc");
+        rpc.setHRcpHandler([](const bfc::BufferView&) -> std::vector<uint8_t> {
+                return std::vector<uint8_t>(4);
+            });
+    }
+
+    auto rpc = sut.root().get("orphanRpc");
+    ASSERT_TRUE(rpc);
+    uint32_t param = 42;
+    auto start = std::chrono::steady_clock::now();
+    auto valueRaw = rpc.call(bfc::BufferView((std::byte*)&param, 4));
+    EXPECT_TRUE(valueRaw.empty());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    rpc.destroy();
+}
+
+TEST_F(BasicTest, shouldBalanceRpcCallsAcrossProviders)
+{
+    if (auto rpc = sut.root().get("groupRpc"))
+    {
+        rpc.destroy();
+    }
+    auto rpc = sut.root().create("groupRpc");
+
+    Client worker1 = Client(config);
+    Client worker2 = Client(config);
+    uint8_t id = 1;
+    for (auto* worker : {&worker1, &worker2})
+    {
+        auto workerRpc = worker->root().get("groupRpc");
+        ASSERT_TRUE(workerRpc);
+        workerRpc.setHRcpHandler([id](const bfc::BufferView&) -> std::vector<uint8_t> {
+                return std::vector<uint8_t>(1, id);
+            });
+        ASSERT_TRUE(workerRpc.registerProvider());
+        id++;
+    }
+
+    std::set<uint8_t> served;
+    uint32_t param = 42;
+    for (int i = 0; i < 4; i++)
+    {
+        auto valueRaw = rpc.call(bfc::BufferView((std::byte*)&param, 4));
+        ASSERT_EQ(1u, valueRaw.size());
+        served.emplace(valueRaw[0]);
+    }
+    EXPECT_EQ(2u, served.size());
+
+    rpc.destroy();
+}
+
+TEST_F(BasicTest, shouldCompleteRpcCallAsynchronously)
+{
+    if (auto rpc = sut.root().get("asyncRpc"))
+    {
+        rpc.destroy();
+    }
+
+    auto rpc = sut.root().create("asyncRpc");
+    std::thread completer;
+    rpc.setAsyncRpcHandler([&completer](const bfc::BufferView& pParam, RpcResponder pResponder) {
+            uint32_t param = *(uint32_t*)pParam.data();
+            completer = std::thread([param, pResponder]() mutable {
+                    uint32_t value = param + 1;
+                    auto rv = std::vector<uint8_t>(4);
+                    std::memcpy(rv.data(), &value, 4);
+                    pResponder.accept(rv);
+                });
+        });
+    {
+        Client sut2 = Client(config);
+        auto rpc = sut2.root().get("asyncRpc");
+        uint32_t param = 42;
+        auto valueRaw = rpc.call(bfc::BufferView((std::byte*)&param, 4));
+        ASSERT_EQ(4u, valueRaw.size());
+        uint32_t value;
+        std::memcpy(&value, valueRaw.data(), 4);
+        EXPECT_EQ(43u, value);
+    }
+    completer.join();
+    rpc.destroy();
+}
+
+TEST_F(BasicTest, shouldStreamRpcResults)
+{
+    if (auto rpc = sut.root().get("streamRpc"))
+    {
+        rpc.destroy();
+    }
+
+    auto rpc = sut.root().create("streamRpc");
+    std::thread producer;
+    rpc.setAsyncRpcHandler([&producer](const bfc::BufferView&, RpcResponder pResponder) {
+            producer = std::thread([pResponder]() mutable {
+                    for (uint8_t i = 0; i < 40; i++)
+                    {
+                        ASSERT_TRUE(pResponder.partial(std::vector<uint8_t>(1, i)));
+                    }
+                    pResponder.accept(std::vector<uint8_t>(1, 40));
+                });
+        });
+    {
+        Client sut2 = Client(config);
+        auto rpc = sut2.root().get("streamRpc");
+        std::vector<uint8_t> partials;
+        uint32_t param = 42;
+        auto valueRaw = rpc.stream(bfc::BufferView((std::byte*)&param, 4), [&partials](std::vector<uint8_t>&& pValue) {
+                partials.insert(partials.end(), pValue.begin(), pValue.end());
+            }, 4);
+        ASSERT_EQ(1u, valueRaw.size());
+        EXPECT_EQ(40u, valueRaw[0]);
+        ASSERT_EQ(40u, partials.size());
+        for (uint8_t i = 0; i < 40; i++)
+        {
+            EXPECT_EQ(i, partials[i]);
+        }
+    }
+    producer.join();
+    rpc.destroy();
+}
+
+TEST_F(BasicTest, shouldDestroyRecursively)
+{
+    auto parent = sut.root().create("recursive");
+    ASSERT_TRUE(parent);
+    auto child = parent.create("child");
+    ASSERT_TRUE(child);
+    ASSERT_TRUE(child.create("grandchild"));
+
+    EXPECT_FALSE(parent.destroy());
+    EXPECT_TRUE(parent.destroy(true));
+
+    Client sut2 = Client(config);
+    EXPECT_FALSE(sut2.root().get("recursive"));
+}
+
+TEST_F(BasicTest, shouldCreateFromTemplate)
+{
+    int value = 21;
+    std::vector<uint8_t> data((uint8_t*)&value, (uint8_t*)&value + sizeof(value));
+
+    auto root = sut.root();
+    auto created = root.create({
+        {"device", NodeTemplate::ROOT, {}},
+        {"temperature", 0, data},
+        {"status", 0, {}},
+        {"code", 2, {}}});
+    ASSERT_EQ(created.size(), 4u);
+    EXPECT_EQ(created[1].value<int>(), 21);
+    EXPECT_TRUE(root.get("device").get("status").get("code"));
+    EXPECT_TRUE(root.create({{"device", NodeTemplate::ROOT, {}}}).empty());
+
+    Client sut2 = Client(config);
+    auto temperature = sut2.root().get("device").get("temperature");
+    ASSERT_TRUE(temperature);
+    temperature.fetch();
+    EXPECT_EQ(temperature.value<int>(), 21);
+    EXPECT_TRUE(created[0].destroy(true));
+}
+
+TEST_F(BasicTest, shouldRetrieveTreeInPages)
+{
+    auto large = sut.root().create("large");
+    ASSERT_TRUE(large);
+    for (auto i = 0u; i < 3; i++)
+    {
+        std::vector<NodeTemplate> nodes;
+        for (auto j = 0u; j < 1000; j++)
+        {
+            nodes.push_back({"n" + std::to_string(i*1000 + j), NodeTemplate::ROOT, {}});
+        }
+        ASSERT_EQ(large.create(nodes).size(), 1000u);
+    }
+
+    Client sut2 = Client(config);
+    sut2.root().loadChildren(true);
+    auto large2 = sut2.root().get("large");
+    ASSERT_TRUE(large2);
+    EXPECT_EQ(large2.children().size(), 3000u);
+    EXPECT_TRUE(large2.get("n2999"));
+
+    EXPECT_TRUE(large.destroy(true));
+}
+
+TEST_F(BasicTest, shouldRetrieveTreeWithValues)
+{
+    int value = 7;
+    std::vector<uint8_t> data((uint8_t*)&value, (uint8_t*)&value + sizeof(value));
+
+    auto created = sut.root().create({
+        {"valued", NodeTemplate::ROOT, data},
+        {"child", 0, data}});
+    ASSERT_EQ(created.size(), 2u);
+
+    Client sut2 = Client(config);
+    auto root = sut2.root();
+    root.loadChildren(true, true);
+    auto child = root.get("valued").get("child");
+    ASSERT_TRUE(child);
+    EXPECT_EQ(child.version(), 1u);
+    EXPECT_EQ(child.value<int>(), 7);
+
+    EXPECT_TRUE(created[0].destroy(true));
+}
+
+TEST_F(BasicTest, shouldNotifyTreeChangesOnlyToLoadedNodes)
+{
+    auto scoped = sut.root().create("scoped");
+    ASSERT_TRUE(scoped);
+
+    Client sut2 = Client(config);
+    sut2.root().loadChildren();
+    std::mutex addedMutex;
+    std::set<std::string> added;
+    sut2.setTreeAddHandler([&](Property pProp) {
+            std::unique_lock<std::mutex> lg(addedMutex);
+            added.emplace(pProp.name());
+        });
+
+    // Note: sut2 loaded the root but never the children of scoped.
+    auto hidden = scoped.create("hidden");
+    auto visible = sut.root().create("visible");
+    ASSERT_TRUE(hidden && visible);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    {
+        std::unique_lock<std::mutex> lg(addedMutex);
+        EXPECT_EQ(1u, added.count("visible"));
+        EXPECT_EQ(0u, added.count("hidden"));
+    }
+    EXPECT_TRUE(visible.destroy());
+    EXPECT_TRUE(scoped.destroy(true));
+}
+
+TEST_F(BasicTest, shouldResumeWithMissedChanges)
+{
+    auto value = sut.root().create("resume_value");
+    auto doomed = sut.root().create("resume_doomed");
+    ASSERT_TRUE(value && doomed);
+    value = uint32_t(1);
+
+    Client sut2 = Client(config);
+    sut2.root().loadChildren();
+    auto value2 = sut2.root().get("resume_value");
+    ASSERT_TRUE(value2);
+    value2.subscribe();
+
+    std::mutex changesMutex;
+    std::set<std::string> added;
+    std::set<std::string> removed;
+    sut2.setTreeAddHandler([&](Property pProp) {
+            std::unique_lock<std::mutex> lg(changesMutex);
+            added.emplace(pProp.name());
+        });
+    sut2.setTreeRemoveHandler([&](Property pProp) {
+            std::unique_lock<std::mutex> lg(changesMutex);
+            removed.emplace(pProp.name());
+        });
+
+    // Note: The tick is 10ms, a change queued just before the disconnect is never flushed to sut2.
+    sut2.disconnect();
+    auto added1 = sut.root().create("resume_added");
+    value = uint32_t(2);
+    EXPECT_TRUE(doomed.destroy());
+    ASSERT_TRUE(added1);
+
+    EXPECT_TRUE(sut2.resume());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        std::unique_lock<std::mutex> lg(changesMutex);
+        EXPECT_EQ(1u, added.count("resume_added"));
+        EXPECT_EQ(1u, removed.count("resume_doomed"));
+    }
+    EXPECT_EQ(2u, value2.value<uint32_t>());
+
+    // Note: The subscription moved to the new connection.
+    value = uint32_t(3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(3u, value2.value<uint32_t>());
+
+    EXPECT_TRUE(value.destroy());
+    EXPECT_TRUE(added1.destroy());
+}
+
+TEST_F(BasicTest, shouldCreateEphemeralWithoutChildren)
+{
+    auto ephemeral = sut.root().create("ephemeral", true);
+    ASSERT_TRUE(ephemeral);
+    EXPECT_FALSE(ephemeral.create("child"));
+
+    Client sut2 = Client(config);
+    EXPECT_TRUE(sut2.root().get("ephemeral"));
+    EXPECT_TRUE(ephemeral.destroy());
+}
+
+TEST_F(BasicTest, shouldRejectValueOfWrongType)
+{
+    auto typed = sut.root().create("typed", false, ValueType::I32);
+    ASSERT_TRUE(typed);
+    EXPECT_TRUE(typed.set({1, 0, 0, 0}));
+    EXPECT_FALSE(typed.set({1, 0}));
+    EXPECT_EQ(1, *typed.value<int32_t>());
+
+    Client sut2 = Client(config);
+    auto typed2 = sut2.root().get("typed");
+    ASSERT_TRUE(typed2);
+    EXPECT_EQ(ValueType::I32, typed2.type());
+    EXPECT_TRUE(typed.destroy());
+}
+
+TEST_F(BasicTest, shouldMaintainAggregates)
+{
+    auto sensors = sut.root().create("sensors");
+    ASSERT_TRUE(sensors);
+    auto a = sensors.create("temp_a", false, ValueType::I32);
+    auto b = sensors.create("temp_b", false, ValueType::I32);
+    auto other = sensors.create("humidity", false, ValueType::I32);
+    a = int32_t(10);
+    b = int32_t(30);
+    other = int32_t(99);
+
+    auto sum = sut.root().aggregate("temp_sum", sensors, AggregateFunction::SUM, "temp_*");
+    auto max = sut.root().aggregate("temp_max", sensors, AggregateFunction::MAX, "temp_*");
+    auto count = sut.root().aggregate("count", sensors, AggregateFunction::COUNT);
+    ASSERT_TRUE(sum && max && count);
+    EXPECT_FALSE(sum.set({0, 0, 0, 0, 0, 0, 0, 0}));
+
+    sum.fetch();
+    max.fetch();
+    count.fetch();
+    EXPECT_EQ(40.0, *sum.value<double>());
+    EXPECT_EQ(30.0, *max.value<double>());
+    EXPECT_EQ(3u, *count.value<uint64_t>());
+
+    b = int32_t(5);
+    EXPECT_TRUE(b.destroy());
+    sum.fetch();
+    max.fetch();
+    count.fetch();
+    EXPECT_EQ(10.0, *sum.value<double>());
+    EXPECT_EQ(10.0, *max.value<double>());
+    EXPECT_EQ(2u, *count.value<uint64_t>());
+
+    EXPECT_TRUE(sum.destroy());
+    EXPECT_TRUE(max.destroy());
+
+    // Note: The remaining aggregate goes along with its source.
+    EXPECT_TRUE(sensors.destroy(true));
+    Client sut2 = Client(config);
+    EXPECT_FALSE(sut2.root().get("count"));
+    EXPECT_FALSE(count.destroy());
+}
+
+TEST_F(BasicTest, shouldQueryByPattern)
+{
+    auto rack = sut.root().create("rack");
+    ASSERT_TRUE(rack);
+    std::vector<NodeTemplate> nodes;
+    for (auto i = 0u; i < 3; i++)
+    {
+        nodes.emplace_back(NodeTemplate{"unit" + std::to_string(i)});
+        auto unit = uint32_t(nodes.size() - 1);
+        nodes.emplace_back(NodeTemplate{"temp", unit, {uint8_t(20 + i)}, ValueType::U8});
+        nodes.emplace_back(NodeTemplate{"fan", unit});
+    }
+    ASSERT_EQ(9u, rack.create(nodes).size());
+
+    auto temps = rack.query("unit*/temp", true);
+    ASSERT_EQ(3u, temps.size());
+    EXPECT_EQ("unit0/temp", temps[0].path);
+    EXPECT_EQ(ValueType::U8, temps[0].type);
+    EXPECT_EQ(std::vector<uint8_t>{22}, temps[2].data);
+
+    EXPECT_EQ(3u, sut.root().query("**/fan").size());
+    EXPECT_EQ(0u, rack.query("unit?/fan/*").size());
+    EXPECT_TRUE(rack.destroy(true));
+}
+
 TEST_F(BasicTest, shouldCleanTree2)
 {
     clean(sut);
@@ -10,12 +10,60 @@
 namespace propertytree
 {
 
+constexpr size_t BULK_CHUNK_SIZE = 1024;
+
 Client::Client(const ClientConfig& pConfig)
+    : mConfig(pConfig)
 {
     mRunner = std::thread([this](){
             mReactor.run();
         });
 
+    for (auto i = 0u; i < mConfig.rpcWorkers; i++)
+    {
+        mRpcWorkers.emplace_back([this](){
+                runRpcWorker();
+            });
+    }
+
+    connect();
+    signin();
+
+    std::unique_lock<std::mutex> lg(mTreeMutex);
+    mTree.emplace(0, std::make_shared<Node>("", std::shared_ptr<Node>(), 0));
+}
+
+Client::~Client()
+{
+    // Note: The reactor goes first so nothing is received on the socket anymore, then the socket is
+    //       marked gone so calls dropped below reject into a closed connection instead of a reused fd.
+    mReactor.stop();
+    mRunner.join();
+
+    std::unique_lock<std::mutex> lgSend(mSendMutex);
+    mConnected = false;
+    if (-1 != mFd)
+    {
+        close(mFd);
+    }
+    mFd = -1;
+    lgSend.unlock();
+
+    std::unique_lock<std::mutex> lgQueue(mRpcQueueMutex);
+    mRpcStopping = true;
+    mRpcQueueCv.notify_all();
+    lgQueue.unlock();
+
+    for (auto& i : mRpcWorkers)
+    {
+        i.join();
+    }
+    mRpcQueue.clear();
+}
+
+void Client::connect()
+{
+    LOGLESS_TRACE();
     mFd = socket(AF_INET, SOCK_STREAM, 0);
     if (-1 == mFd)
     {
@@ -25,9 +73,9 @@ Client::Client(const ClientConfig& pConfig)
     sockaddr_in server;
     std::memset(&server, 0, sizeof(server));
     server.sin_family = AF_INET;
-    server.sin_port = ntohs(pConfig.port);
+    server.sin_port = ntohs(mConfig.port);
 
-    auto res = inet_pton(AF_INET, pConfig.ip.c_str(), &server.sin_addr.s_addr);
+    auto res = inet_pton(AF_INET, mConfig.ip.c_str(), &server.sin_addr.s_addr);
 
     if (-1 == res)
     {
@@ -35,22 +83,33 @@ Client::Client(const ClientConfig& pConfig)
     }
 
     char loc[24];
-    inet_ntop(AF_INET, &pConfig.ip, loc, sizeof(loc));
+    inet_ntop(AF_INET, &mConfig.ip, loc, sizeof(loc));
 
-    res = connect(mFd, (sockaddr*)&server, sizeof(server));
+    res = ::connect(mFd, (sockaddr*)&server, sizeof(server));
 
     if (-1 == res)
     {
-        throw std::runtime_error(strerror(errno));
+        auto error = errno;
+        close(mFd);
+        mFd = -1;
+        throw std::runtime_error(strerror(error));
     }
 
+    mReadState = WAIT_HEADER;
+    mBuffIdx = 0;
+    mConnected = true;
+
     if (!mReactor.addHandler(mFd, [this](){
             handleRead();
         }))
     {
         throw std::runtime_error("Failed to add client socket to EpollReactor!");
     }
+}
 
+void Client::signin()
+{
+    LOGLESS_TRACE();
     PropertyTreeProtocol message = PropertyTreeMessage{};
     auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
     propertyTreeMessage.message = SigninRequest{};
@@ -63,15 +122,68 @@ Client::Client(const ClientConfig& pConfig)
         throw std::runtime_error("signin failure!");
     }
 
-    std::unique_lock<std::mutex> lg(mTreeMutex);
-    mTree.emplace(0, std::make_shared<Node>("", std::shared_ptr<Node>(), 0));
+    auto& signinAccept = std::get<SigninAccept>(response);
+    mToken = signinAccept.token;
+    mSequence = signinAccept.sequence;
 }
 
-Client::~Client()
+bool Client::resume()
 {
-    mReactor.stop();
-    mRunner.join();
+    LOGLESS_TRACE();
+    if (!mConnected)
+    {
+        connect();
+    }
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.message = ResumeRequest{};
+    auto& resumeRequest = std::get<ResumeRequest>(propertyTreeMessage.message);
+    resumeRequest.token = mToken;
+    resumeRequest.sequence = mSequence;
+
+    auto trId = addTransaction(std::move(message));
+    auto response = waitTransaction(trId);
+
+    if (cum::GetIndexByType<PropertyTreeMessages, ResumeAccept>() == response.index())
+    {
+        auto& resumeAccept = std::get<ResumeAccept>(response);
+        advanceSequence(resumeAccept.sequence);
+        return true;
+    }
+    else if (cum::GetIndexByType<PropertyTreeMessages, ResumeReject>() == response.index())
+    {
+        auto& resumeReject = std::get<ResumeReject>(response);
+        Logless("WRN Client: resume rejected cause=_, signing in again.", (int)resumeReject.cause);
+        signin();
+        return false;
+    }
+    else
+    {
+        throw std::runtime_error("protocol error!");
+    }
+}
+
+bool Client::connected() const
+{
+    return mConnected;
+}
+
+void Client::disconnect()
+{
+    LOGLESS_TRACE();
+    std::unique_lock<std::mutex> lg(mSendMutex);
+    mConnected = false;
+    mReactor.removeHandler(mFd);
     close(mFd);
+    mFd = -1;
+}
+
+void Client::advanceSequence(uint64_t pSequence)
+{
+    // Note: Notifications and responses use different lanes, an older sequence may come last.
+    auto sequence = mSequence.load();
+    while (sequence < pSequence && !mSequence.compare_exchange_weak(sequence, pSequence));
 }
 
 Property Client::root()
@@ -80,7 +192,7 @@ Property Client::root()
     return Property(*this, mTree.find(0)->second);
 }
 
-Property Client::create(Property& pParent, const std::string& pName)
+Property Client::create(Property& pParent, const std::string& pName, bool pEphemeral, ValueType pType)
 {
     LOGLESS_TRACE();
     auto& node = pParent.node();
@@ -99,6 +211,8 @@ Property Client::create(Property& pParent, const std::string& pName)
     auto& createRequest = std::get<CreateRequest>(propertyTreeMessage.message);
     createRequest.name = pName;
     createRequest.parentUuid = node->uuid;
+    createRequest.ephemeral = pEphemeral;
+    createRequest.type = pType;
 
     auto trId = addTransaction(std::move(message));
     auto response = waitTransaction(trId);
@@ -124,6 +238,7 @@ Property Client::create(Property& pParent, const std::string& pName)
             return Property(*this, foundIt->second);
         }
         auto newNode = std::make_shared<Node>(pName, node, createAccept.uuid);
+        newNode->type = pType;
         mTree.emplace(createAccept.uuid, newNode);
         std::unique_lock<std::mutex> lgNode(node->childrenMutex);
         node->children.emplace(pName, newNode);
@@ -136,67 +251,278 @@ Property Client::create(Property& pParent, const std::string& pName)
     }
 }
 
-Property Client::get(Property& pParent, const std::string& pName, bool pRecursive)
+std::vector<Property> Client::create(Property& pParent, const std::vector<NodeTemplate>& pTemplate)
 {
     LOGLESS_TRACE();
     auto& node = pParent.node();
 
-    std::unique_lock<std::mutex> lg(node->childrenMutex);
-    auto foundIt = node->children.find(pName);
-    if (!pRecursive && node->children.end()!= foundIt)
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.message = BulkCreateRequest{};
+    auto& bulkCreateRequest = std::get<BulkCreateRequest>(propertyTreeMessage.message);
+    bulkCreateRequest.parentUuid = node->uuid;
+    for (auto& i : pTemplate)
     {
-        return Property(*this, foundIt->second);
+        bulkCreateRequest.nodes.emplace_back();
+        auto& templateNode = bulkCreateRequest.nodes.back();
+        templateNode.name = i.name;
+        templateNode.parentIndex = i.parent;
+        templateNode.data = i.data;
+        templateNode.type = i.type;
     }
-    lg.unlock();
 
+    auto trId = addTransaction(std::move(message));
+    auto response = waitTransaction(trId);
+
+    std::vector<Property> rv;
+    if (cum::GetIndexByType<PropertyTreeMessages, BulkCreateReject>() == response.index())
+    {
+        return rv;
+    }
+    else if (cum::GetIndexByType<PropertyTreeMessages, BulkCreateAccept>() == response.index())
+    {
+        auto& bulkCreateAccept = std::get<BulkCreateAccept>(response);
+        if (bulkCreateAccept.uuids.size() != pTemplate.size())
+        {
+            throw std::runtime_error("protocol error!");
+        }
+
+        std::vector<std::shared_ptr<Node>> created;
+        created.reserve(pTemplate.size());
+        rv.reserve(pTemplate.size());
+
+        std::unique_lock<std::mutex> lgTree(mTreeMutex);
+        for (auto i = 0u; i < pTemplate.size(); i++)
+        {
+            auto& entry = pTemplate[i];
+            auto uuid = bulkCreateAccept.uuids[i];
+            auto& parentNode = NodeTemplate::ROOT == entry.parent ? node : created[entry.parent];
+
+            std::shared_ptr<Node> newNode;
+
+            // Note: Case when TreeUpdateNotification came first.
+            auto foundIt = mTree.find(uuid);
+            if (mTree.end() != foundIt)
+            {
+                newNode = foundIt->second;
+            }
+            else
+            {
+                newNode = std::make_shared<Node>(entry.name, parentNode, uuid);
+                newNode->type = entry.type;
+                mTree.emplace(uuid, newNode);
+                std::unique_lock<std::mutex> lgNode(parentNode->childrenMutex);
+                parentNode->children.emplace(entry.name, newNode);
+            }
+
+            if (entry.data.size())
+            {
+                std::unique_lock<std::mutex> lgData(newNode->dataMutex);
+                if (!newNode->version)
+                {
+                    newNode->data = entry.data;
+                    newNode->version = 1;
+                }
+            }
+
+            created.emplace_back(newNode);
+            rv.emplace_back(Property(*this, newNode));
+        }
+        return rv;
+    }
+    else
+    {
+        throw std::runtime_error("protocol error!");
+    }
+}
+
+std::vector<QueryResult> Client::query(Property& pRoot, const std::string& pPattern, bool pWithValue)
+{
+    LOGLESS_TRACE();
+    std::vector<QueryResult> rv;
+    uint64_t continuation = 0;
+
+    // Note: Large results are sent in pages, the matches are not added to the local tree.
+    do
+    {
+        PropertyTreeProtocol message = PropertyTreeMessage{};
+        auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+        propertyTreeMessage.message = QueryRequest{};
+        auto& queryRequest = std::get<QueryRequest>(propertyTreeMessage.message);
+        queryRequest.rootUuid = pRoot.uuid();
+        queryRequest.pattern = pPattern;
+        queryRequest.withValue = pWithValue;
+        queryRequest.continuation = continuation;
+
+        auto trId = addTransaction(std::move(message));
+        auto response = waitTransaction(trId);
+
+        if (cum::GetIndexByType<PropertyTreeMessages, QueryResponse>() == response.index())
+        {
+            auto& queryResponse = std::get<QueryResponse>(response);
+            for (auto i = 0u; i < queryResponse.matches.size(); i++)
+            {
+                auto& match = queryResponse.matches[i];
+                rv.emplace_back(QueryResult{std::move(match.path), match.uuid, match.type});
+                if (i < queryResponse.values.size())
+                {
+                    auto& value = queryResponse.values[i];
+                    rv.back().version = value.version;
+                    rv.back().data.assign(value.data.begin(), value.data.end());
+                }
+            }
+            continuation = queryResponse.continuation;
+        }
+        else if (cum::GetIndexByType<PropertyTreeMessages, QueryReject>() == response.index())
+        {
+            if (continuation)
+            {
+                // Note: The node to resume from was removed meanwhile, the result is partial.
+                Logless("WRN Client: Query continuation _ is no longer valid.", continuation);
+            }
+            break;
+        }
+        else
+        {
+            throw std::runtime_error("protocol error!");
+        }
+    } while (continuation);
+
+    return rv;
+}
+
+Property Client::aggregate(Property& pParent, const std::string& pName, Property& pSource, AggregateFunction pFunction, const std::string& pPattern)
+{
+    LOGLESS_TRACE();
+    auto& node = pParent.node();
 
     PropertyTreeProtocol message = PropertyTreeMessage{};
     auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-    propertyTreeMessage.message = TreeInfoRequest{};
-    auto& treeInfoRequest = std::get<TreeInfoRequest>(propertyTreeMessage.message);
-    treeInfoRequest.name = pName;
-    treeInfoRequest.parentUuid = pParent.uuid();
-    treeInfoRequest.recursive = pRecursive;
+    propertyTreeMessage.message = AggregateCreateRequest{};
+    auto& aggregateCreateRequest = std::get<AggregateCreateRequest>(propertyTreeMessage.message);
+    aggregateCreateRequest.name = pName;
+    aggregateCreateRequest.parentUuid = node->uuid;
+    aggregateCreateRequest.sourceUuid = pSource.uuid();
+    aggregateCreateRequest.pattern = pPattern;
+    aggregateCreateRequest.function = pFunction;
 
     auto trId = addTransaction(std::move(message));
     auto response = waitTransaction(trId);
 
-    if (cum::GetIndexByType<PropertyTreeMessages, TreeInfoResponse>() == response.index())
+    if (cum::GetIndexByType<PropertyTreeMessages, CreateReject>() == response.index())
     {
-        auto& treeInfoResponse = std::get<TreeInfoResponse>(response);
-        addNodes(treeInfoResponse.nodeToAddList);
+        return Property(*this, nullptr);
+    }
+    else if (cum::GetIndexByType<PropertyTreeMessages, CreateAccept>() == response.index())
+    {
+        auto& createAccept = std::get<CreateAccept>(response);
+        std::unique_lock<std::mutex> lgTree(mTreeMutex);
 
-        if ("." == pName)
+        // Note: Case when TreeUpdateNotification came first.
+        auto foundIt = mTree.find(createAccept.uuid);
+        if (mTree.end() != foundIt)
         {
-            return pParent;
+            return Property(*this, foundIt->second);
         }
+        auto newNode = std::make_shared<Node>(pName, node, createAccept.uuid);
+        newNode->type = AggregateFunction::COUNT == pFunction ? ValueType::U64 : ValueType::F64;
+        mTree.emplace(createAccept.uuid, newNode);
+        std::unique_lock<std::mutex> lgNode(node->childrenMutex);
+        node->children.emplace(pName, newNode);
+        lgTree.unlock();
+        return Property(*this, newNode);
+    }
+    else
+    {
+        throw std::runtime_error("protocol error!");
+    }
+}
 
-        auto nodeUuid = treeInfoResponse.nodeToAddList[0].uuid;
-
-        std::unique_lock<std::mutex> lg(mTreeMutex);
-        auto foundIt = mTree.find(nodeUuid);
+Property Client::get(Property& pParent, const std::string& pName, bool pRecursive, bool pWithValue)
+{
+    LOGLESS_TRACE();
+    auto& node = pParent.node();
 
+    std::unique_lock<std::mutex> lg(node->childrenMutex);
+    auto foundIt = node->children.find(pName);
+    if (!pRecursive && node->children.end()!= foundIt)
+    {
         return Property(*this, foundIt->second);
     }
-    else if (cum::GetIndexByType<PropertyTreeMessages, TreeInfoErrorResponse>() == response.index())
+    lg.unlock();
+
+
+    uint64_t nodeUuid = 0;
+    uint64_t continuation = 0;
+
+    // Note: Large subtrees are sent in pages, each page is added as soon as it arrives.
+    do
     {
-        return Property(*this, nullptr);
+        PropertyTreeProtocol message = PropertyTreeMessage{};
+        auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+        propertyTreeMessage.message = TreeInfoRequest{};
+        auto& treeInfoRequest = std::get<TreeInfoRequest>(propertyTreeMessage.message);
+        treeInfoRequest.name = pName;
+        treeInfoRequest.parentUuid = pParent.uuid();
+        treeInfoRequest.recursive = pRecursive;
+        treeInfoRequest.continuation = continuation;
+        treeInfoRequest.withValue = pWithValue;
+
+        auto trId = addTransaction(std::move(message));
+        auto response = waitTransaction(trId);
+
+        if (cum::GetIndexByType<PropertyTreeMessages, TreeInfoResponse>() == response.index())
+        {
+            auto& treeInfoResponse = std::get<TreeInfoResponse>(response);
+            if (!continuation && "." != pName)
+            {
+                nodeUuid = treeInfoResponse.nodeToAddList[0].uuid;
+            }
+            addNodes(treeInfoResponse.nodeToAddList);
+            setValues(treeInfoResponse.nodeToAddList, treeInfoResponse.values);
+            continuation = treeInfoResponse.continuation;
+        }
+        else if (cum::GetIndexByType<PropertyTreeMessages, TreeInfoErrorResponse>() == response.index())
+        {
+            if (!continuation)
+            {
+                return Property(*this, nullptr);
+            }
+            // Note: The node to resume from was removed meanwhile, its removal is notified separately.
+            Logless("WRN Client: TreeInfo continuation _ is no longer valid.", continuation);
+            break;
+        }
+        else
+        {
+            throw std::runtime_error("protocol error!");
+        }
+    } while (continuation);
+
+    if ("." == pName)
+    {
+        return pParent;
     }
-    else
+
+    std::unique_lock<std::mutex> lgTree(mTreeMutex);
+    auto nodeIt = mTree.find(nodeUuid);
+    if (mTree.end() == nodeIt)
     {
-        throw std::runtime_error("protocol error!");
+        return Property(*this, nullptr);
     }
+    return Property(*this, nodeIt->second);
 }
 
 void Client::handle(uint16_t, TreeUpdateNotification&& pMsg)
 {
     addNodes(pMsg.nodeToAddList);
     removeNodes(pMsg.nodeToDelete);
+    advanceSequence(pMsg.sequence);
 }
 
 void Client::handle(uint16_t, UpdateNotification&& pMsg)
 {
     LOGLESS_TRACE();
+    advanceSequence(pMsg.sequence);
     std::unique_lock<std::mutex> lgTree(mTreeMutex);
     auto nodeIt = mTree.find(pMsg.uuid);
     if (mTree.end() == nodeIt)
@@ -208,6 +534,14 @@ void Client::handle(uint16_t, UpdateNotification&& pMsg)
 
     std::unique_lock<std::mutex> lgData(node->dataMutex);
 
+    // Note: Notifications travel on a lower priority lane than responses and may arrive after a
+    //       newer value from GetAccept or SubscribeResponse.
+    if (pMsg.version <= node->version)
+    {
+        return;
+    }
+
+    node->version = pMsg.version;
     if (node->data.size() == pMsg.data.size())
     {
         std::memcpy(node->data.data(), pMsg.data.data(), pMsg.data.size());
@@ -225,46 +559,221 @@ void Client::handle(uint16_t, UpdateNotification&& pMsg)
     }
 }
 
-void Client::handle(uint16_t pTransactionId, RpcRequest&& pMsg)
+void Client::handle(uint16_t pTransactionId, HearbeatRequest&&)
 {
     LOGLESS_TRACE();
     PropertyTreeProtocol message = PropertyTreeMessage{};
     auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-    propertyTreeMessage.message = RpcReject{};
+    propertyTreeMessage.message = HearbeatResponse{};
     propertyTreeMessage.transactionId = pTransactionId;
-    auto& rpcReject = std::get<RpcReject>(propertyTreeMessage.message);
+    send(std::move(message));
+}
+
+void Client::handle(uint16_t pTransactionId, RpcRequest&& pMsg)
+{
+    LOGLESS_TRACE();
+    RpcResponder responder(*this, pTransactionId, pMsg.callId, pMsg.window);
+    if (pMsg.window)
+    {
+        std::unique_lock<std::mutex> lgStreaming(mStreamingCallsMutex);
+        mStreamingCalls.emplace(pMsg.callId, responder.mCall);
+    }
 
     std::unique_lock<std::mutex> lg(mTreeMutex);
     auto nodeIt = mTree.find(pMsg.uuid);
     if (mTree.end() == nodeIt)
     {
-        rpcReject.cause = Cause::NOT_FOUND;
-        send(std::move(message));
+        responder.reject(Cause::NOT_FOUND);
         return;
     }
     auto node = nodeIt->second;
     lg.unlock();
 
+    // Note: Handlers are copied out so that they don't run under rcpHandlerMutex and may run concurrently.
     std::unique_lock<std::mutex> lgHandler(node->rcpHandlerMutex);
-    if (node->rcpHandler)
+    auto handler = node->rcpHandler;
+    auto asyncHandler = node->asyncRpcHandler;
+    lgHandler.unlock();
+
+    if (!handler && !asyncHandler)
     {
-        propertyTreeMessage.message = RpcAccept{};
-        auto& rcpAccept = std::get<RpcAccept>(propertyTreeMessage.message);
+        responder.reject(Cause::NO_HANDLER);
+        return;
+    }
+
+    auto task = [handler = std::move(handler), asyncHandler = std::move(asyncHandler), responder,
+        param = std::move(pMsg.param)]() mutable {
+            auto paramView = bfc::BufferView((std::byte*)param.data(), param.size());
+            if (asyncHandler)
+            {
+                asyncHandler(paramView, std::move(responder));
+                return;
+            }
+            responder.accept(handler(paramView));
+        };
 
-        auto rv = node->rcpHandler(bfc::BufferView((std::byte*)pMsg.param.data(), pMsg.param.size()));
-        rcpAccept.value.resize(rv.size());
-        std::memcpy(rcpAccept.value.data(), rv.data(), rv.size());
-        send(std::move(message));
+    if (mRpcWorkers.empty())
+    {
+        task();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lgQueue(mRpcQueueMutex);
+    mRpcQueue.emplace_back(std::move(task));
+    mRpcQueueCv.notify_one();
+}
+
+void Client::runRpcWorker()
+{
+    std::unique_lock<std::mutex> lg(mRpcQueueMutex);
+    while (true)
+    {
+        mRpcQueueCv.wait(lg, [this](){
+                return mRpcStopping || mRpcQueue.size();
+            });
+
+        if (mRpcStopping)
+        {
+            return;
+        }
+
+        auto task = std::move(mRpcQueue.front());
+        mRpcQueue.pop_front();
+        lg.unlock();
+        task();
+        lg.lock();
+    }
+}
+
+void Client::handle(uint16_t, RpcCredit&& pMsg)
+{
+    LOGLESS_TRACE();
+    std::unique_lock<std::mutex> lg(mStreamingCallsMutex);
+    auto callIt = mStreamingCalls.find(pMsg.callId);
+    if (mStreamingCalls.end() == callIt)
+    {
+        return;
+    }
+    auto call = callIt->second.lock();
+    lg.unlock();
+
+    if (!call)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lgCredit(call->creditMutex);
+    call->credit += pMsg.credit;
+    call->creditCv.notify_all();
+}
+
+void Client::sendRpcResponse(PropertyTreeProtocol&& pMsg)
+{
+    // Note: Responses may come from any thread, a lost connection only loses this response as the
+    //       server fails the call on its side.
+    try
+    {
+        send(std::move(pMsg));
+    }
+    catch (const std::exception& pError)
+    {
+        Logless("WRN Client: rpc response not sent, error=_", pError.what());
+    }
+}
+
+RpcResponder::RpcResponder(Client& pClient, uint16_t pTransactionId, uint64_t pCallId, uint32_t pWindow)
+    : mCall(std::make_shared<Call>(pClient, pTransactionId, pCallId, pWindow))
+{
+}
+
+bool RpcResponder::partial(const std::vector<uint8_t>& pValue)
+{
+    auto& call = *mCall;
+    if (!call.streaming)
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lg(call.creditMutex);
+    call.creditCv.wait_for(lg, call.client.mConfig.transactionTimeout, [&call](){
+            return call.credit || call.completed;
+        });
+    if (!call.credit || call.completed)
+    {
+        return false;
+    }
+    call.credit--;
+    lg.unlock();
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = call.transactionId;
+    propertyTreeMessage.message = RpcPartial{};
+    auto& rpcPartial = std::get<RpcPartial>(propertyTreeMessage.message);
+    rpcPartial.callId = call.callId;
+    rpcPartial.value = pValue;
+    call.client.sendRpcResponse(std::move(message));
+    return true;
+}
+
+void RpcResponder::accept(const std::vector<uint8_t>& pValue)
+{
+    if (mCall->completed.exchange(true))
+    {
+        return;
+    }
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = mCall->transactionId;
+    propertyTreeMessage.message = RpcAccept{};
+    auto& rpcAccept = std::get<RpcAccept>(propertyTreeMessage.message);
+    rpcAccept.value = pValue;
+    rpcAccept.callId = mCall->callId;
+    mCall->client.sendRpcResponse(std::move(message));
+}
+
+void RpcResponder::reject(Cause pCause)
+{
+    if (mCall->completed.exchange(true))
+    {
+        return;
+    }
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = mCall->transactionId;
+    propertyTreeMessage.message = RpcReject{};
+    auto& rpcReject = std::get<RpcReject>(propertyTreeMessage.message);
+    rpcReject.cause = pCause;
+    rpcReject.callId = mCall->callId;
+    mCall->client.sendRpcResponse(std::move(message));
+}
+
+RpcResponder::Call::~Call()
+{
+    if (streaming)
+    {
+        std::unique_lock<std::mutex> lg(client.mStreamingCallsMutex);
+        client.mStreamingCalls.erase(callId);
+    }
+
+    if (completed)
+    {
         return;
     }
-    lgHandler.unlock();
 
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = transactionId;
+    propertyTreeMessage.message = RpcReject{};
+    auto& rpcReject = std::get<RpcReject>(propertyTreeMessage.message);
     rpcReject.cause = Cause::NO_HANDLER;
-    send(std::move(message));
-    return;
+    rpcReject.callId = callId;
+    client.sendRpcResponse(std::move(message));
 }
 
-void Client::commit(Property& pProp)
+bool Client::commit(Property& pProp)
 {
     LOGLESS_TRACE();
     PropertyTreeProtocol message = PropertyTreeMessage{};
@@ -281,7 +790,15 @@ void Client::commit(Property& pProp)
     auto trId = addTransaction(std::move(message));
     auto response = waitTransaction(trId);
 
-    if (cum::GetIndexByType<PropertyTreeMessages, SetValueAccept>() != response.index())
+    if (cum::GetIndexByType<PropertyTreeMessages, SetValueAccept>() == response.index())
+    {
+        return true;
+    }
+    else if (cum::GetIndexByType<PropertyTreeMessages, SetValueReject>() == response.index())
+    {
+        return false;
+    }
+    else
     {
         throw std::runtime_error("protocol error!");
     }
@@ -304,6 +821,7 @@ void Client::fetch(Property& pProp)
         auto& getAccept = std::get<GetAccept>(response);
         auto& node = *pProp.node();
         std::unique_lock<std::mutex> lg(node.dataMutex);
+        node.version = getAccept.version;
         if (node.data.size() == getAccept.data.size())
         {
             std::memcpy(node.data.data(), getAccept.data.data(), getAccept.data.size());
@@ -319,6 +837,52 @@ void Client::fetch(Property& pProp)
     }
 }
 
+bool Client::registerProvider(Property& pProp)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.message = ProviderRegisterRequest{};
+    auto& providerRegisterRequest = std::get<ProviderRegisterRequest>(propertyTreeMessage.message);
+    providerRegisterRequest.uuid = pProp.uuid();
+
+    auto trId = addTransaction(std::move(message));
+    auto response = waitTransaction(trId);
+
+    if (cum::GetIndexByType<PropertyTreeMessages, ProviderRegisterResponse>() == response.index())
+    {
+        auto& providerRegisterResponse = std::get<ProviderRegisterResponse>(response);
+        return Cause::OK == providerRegisterResponse.cause;
+    }
+    else
+    {
+        throw std::runtime_error("protocol error!");
+    }
+}
+
+bool Client::unregisterProvider(Property& pProp)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.message = ProviderUnregisterRequest{};
+    auto& providerUnregisterRequest = std::get<ProviderUnregisterRequest>(propertyTreeMessage.message);
+    providerUnregisterRequest.uuid = pProp.uuid();
+
+    auto trId = addTransaction(std::move(message));
+    auto response = waitTransaction(trId);
+
+    if (cum::GetIndexByType<PropertyTreeMessages, ProviderUnregisterResponse>() == response.index())
+    {
+        auto& providerUnregisterResponse = std::get<ProviderUnregisterResponse>(response);
+        return Cause::OK == providerUnregisterResponse.cause;
+    }
+    else
+    {
+        throw std::runtime_error("protocol error!");
+    }
+}
+
 bool Client::subscribe(Property& pProp)
 {
     LOGLESS_TRACE();
@@ -334,7 +898,16 @@ bool Client::subscribe(Property& pProp)
     if (cum::GetIndexByType<PropertyTreeMessages, SubscribeResponse>() == response.index())
     {
         auto& subscribeResponse = std::get<SubscribeResponse>(response);
-        return subscribeResponse.cause == Cause::OK;
+        if (subscribeResponse.cause != Cause::OK)
+        {
+            return false;
+        }
+
+        auto& node = *pProp.node();
+        std::unique_lock<std::mutex> lg(node.dataMutex);
+        node.version = subscribeResponse.version;
+        node.data = std::move(subscribeResponse.data);
+        return true;
     }
     else
     {
@@ -365,7 +938,107 @@ bool Client::unsubscribe(Property& pProp)
     }
 }
 
-bool Client::destroy(Property& pProp)
+std::vector<bool> Client::subscribe(std::vector<Property>& pProps)
+{
+    LOGLESS_TRACE();
+    std::vector<bool> rv;
+    rv.reserve(pProps.size());
+
+    while (rv.size() < pProps.size())
+    {
+        PropertyTreeProtocol message = PropertyTreeMessage{};
+        auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+        propertyTreeMessage.message = BulkSubscribeRequest{};
+        auto& bulkSubscribeRequest = std::get<BulkSubscribeRequest>(propertyTreeMessage.message);
+
+        auto offset = rv.size();
+        auto count = std::min(BULK_CHUNK_SIZE, pProps.size() - offset);
+        bulkSubscribeRequest.uuids.reserve(count);
+        for (auto i = offset; i < offset + count; i++)
+        {
+            bulkSubscribeRequest.uuids.emplace_back(pProps[i].uuid());
+        }
+
+        auto trId = addTransaction(std::move(message));
+        auto response = waitTransaction(trId);
+
+        if (cum::GetIndexByType<PropertyTreeMessages, BulkSubscribeResponse>() != response.index())
+        {
+            throw std::runtime_error("protocol error!");
+        }
+
+        // Note: The server may handle only a prefix of the list to keep the response in one frame.
+        auto& results = std::get<BulkSubscribeResponse>(response).results;
+        if (!results.size() || results.size() > count)
+        {
+            throw std::runtime_error("protocol error!");
+        }
+
+        for (auto i = 0u; i < results.size(); i++)
+        {
+            auto& result = results[i];
+            if (result.cause != Cause::OK)
+            {
+                rv.emplace_back(false);
+                continue;
+            }
+
+            auto& node = *pProps[offset + i].node();
+            std::unique_lock<std::mutex> lg(node.dataMutex);
+            node.version = result.version;
+            node.data = std::move(result.data);
+            rv.emplace_back(true);
+        }
+    }
+
+    return rv;
+}
+
+std::vector<bool> Client::unsubscribe(std::vector<Property>& pProps)
+{
+    LOGLESS_TRACE();
+    std::vector<bool> rv;
+    rv.reserve(pProps.size());
+
+    while (rv.size() < pProps.size())
+    {
+        PropertyTreeProtocol message = PropertyTreeMessage{};
+        auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+        propertyTreeMessage.message = BulkUnsubscribeRequest{};
+        auto& bulkUnsubscribeRequest = std::get<BulkUnsubscribeRequest>(propertyTreeMessage.message);
+
+        auto offset = rv.size();
+        auto count = std::min(BULK_CHUNK_SIZE, pProps.size() - offset);
+        bulkUnsubscribeRequest.uuids.reserve(count);
+        for (auto i = offset; i < offset + count; i++)
+        {
+            bulkUnsubscribeRequest.uuids.emplace_back(pProps[i].uuid());
+        }
+
+        auto trId = addTransaction(std::move(message));
+        auto response = waitTransaction(trId);
+
+        if (cum::GetIndexByType<PropertyTreeMessages, BulkUnsubscribeResponse>() != response.index())
+        {
+            throw std::runtime_error("protocol error!");
+        }
+
+        auto& causes = std::get<BulkUnsubscribeResponse>(response).causes;
+        if (causes.size() != count)
+        {
+            throw std::runtime_error("protocol error!");
+        }
+
+        for (auto i : causes)
+        {
+            rv.emplace_back(i == Cause::OK);
+        }
+    }
+
+    return rv;
+}
+
+bool Client::destroy(Property& pProp, bool pRecursive)
 {
     LOGLESS_TRACE();
     PropertyTreeProtocol message = PropertyTreeMessage{};
@@ -373,6 +1046,7 @@ bool Client::destroy(Property& pProp)
     propertyTreeMessage.message = DeleteRequest{};
     auto& deleteRequest = std::get<DeleteRequest>(propertyTreeMessage.message);
     deleteRequest.uuid = pProp.uuid();
+    deleteRequest.recursive = pRecursive;
 
     auto trId = addTransaction(std::move(message));
     auto response = waitTransaction(trId);
@@ -439,8 +1113,66 @@ std::vector<uint8_t> Client::call(Property& pProp, const bfc::BufferView& pValue
         auto& rpcAccept = std::get<RpcAccept>(response);
         return std::move(rpcAccept.value);
     }
-    else if (cum::GetIndexByType<PropertyTreeMessages, RpcAccept>() == response.index())
+    else if (cum::GetIndexByType<PropertyTreeMessages, RpcReject>() == response.index())
     {
+        auto& rpcReject = std::get<RpcReject>(response);
+        Logless("WRN Client: call rejected cause=_", (int)rpcReject.cause);
+        return {};
+    }
+    else
+    {
+        throw std::runtime_error("protocol error!");
+    }
+}
+
+std::vector<uint8_t> Client::stream(Property& pProp, const bfc::BufferView& pValue,
+    std::function<void(std::vector<uint8_t>&&)> pOnPartial, uint32_t pWindow)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.message = RpcRequest{};
+    auto& rpcRequest = std::get<RpcRequest>(propertyTreeMessage.message);
+    rpcRequest.uuid = pProp.uuid();
+    rpcRequest.window = std::max(pWindow, 1u);
+
+    rpcRequest.param.reserve(pValue.size());
+    for (auto i=0u; i<pValue.size(); i++)
+    {
+        rpcRequest.param.emplace_back((uint8_t)pValue.data()[i]);
+    }
+
+    // Note: The window is reopened once half of it was consumed.
+    auto window = rpcRequest.window;
+    uint32_t consumed = 0;
+    auto trId = addTransaction(std::move(message), [this, &pOnPartial, &consumed, window](RpcPartial&& pPartial){
+            pOnPartial(std::move(pPartial.value));
+            if (++consumed < std::max(window/2, 1u))
+            {
+                return;
+            }
+
+            PropertyTreeProtocol message = PropertyTreeMessage{};
+            auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+            propertyTreeMessage.transactionId = 0xFFFF;
+            propertyTreeMessage.message = RpcCredit{};
+            auto& rpcCredit = std::get<RpcCredit>(propertyTreeMessage.message);
+            rpcCredit.callId = pPartial.callId;
+            rpcCredit.credit = consumed;
+            consumed = 0;
+            send(std::move(message));
+        });
+    auto response = waitTransaction(trId);
+
+    if (cum::GetIndexByType<PropertyTreeMessages, RpcAccept>() == response.index())
+    {
+        auto& rpcAccept = std::get<RpcAccept>(response);
+        return std::move(rpcAccept.value);
+    }
+    else if (cum::GetIndexByType<PropertyTreeMessages, RpcReject>() == response.index())
+    {
+        auto& rpcReject = std::get<RpcReject>(response);
+        Logless("WRN Client: stream rejected cause=_", (int)rpcReject.cause);
         return {};
     }
     else
@@ -483,11 +1215,15 @@ void Client::handleRead()
 
     if (-1 == res)
     {
-        throw std::runtime_error(strerror(errno));
+        Logless("WRN Client: read error=_, disconnecting.", strerror(errno));
+        disconnect();
+        return;
     }
     if (0 == res)
     {
-        throw std::runtime_error("Server disconnected!");
+        Logless("WRN Client: server disconnected.");
+        disconnect();
+        return;
     }
 
     mBuffIdx += res;
@@ -528,7 +1264,7 @@ void Client::send(PropertyTreeProtocol&& pMsg)
 {
     LOGLESS_TRACE();
 
-    std::byte buffer[512];
+    std::byte buffer[1024*64];
     auto& msgSize = *(new (buffer) uint16_t(0));
     cum::per_codec_ctx context(buffer+sizeof(msgSize), sizeof(buffer)-sizeof(msgSize));
     encode_per(pMsg, context);
@@ -540,6 +1276,13 @@ void Client::send(PropertyTreeProtocol&& pMsg)
     str("root", pMsg, stred, true);
     Logless("DBG Client: send: encoded=_ raw=_", stred.c_str(), BufferLog(msgSize+2, buffer));
 
+    // Note: RPC responses are sent from worker threads, frames must not interleave.
+    std::unique_lock<std::mutex> lg(mSendMutex);
+    if (!mConnected)
+    {
+        throw std::runtime_error("not connected!");
+    }
+
     auto res = ::send(mFd, buffer, msgSize+2, 0);
     if (-1 == res)
     {
@@ -558,6 +1301,19 @@ void Client::handle(PropertyTreeMessage&& pMsg)
     {
         auto& transaction = foundIt->second;
         std::unique_lock<std::mutex> lg(transaction.mutex);
+
+        // Note: Partials are handled with mTransactionsMutex held, so the waiting side can't drop the
+        //       transaction and the state onPartial refers to under it.
+        if (cum::GetIndexByType<PropertyTreeMessages, RpcPartial>() == pMsg.message.index())
+        {
+            if (transaction.onPartial)
+            {
+                transaction.onPartial(std::move(std::get<RpcPartial>(pMsg.message)));
+                transaction.progress++;
+            }
+            return;
+        }
+
         transaction.satisfied = true;
         transaction.message = std::move(pMsg.message);
         transaction.cv.notify_one();
@@ -609,6 +1365,31 @@ void Client::removeNodes(const std::vector<uint64_t>& pNodes)
     }
 }
 
+void Client::setValues(NamedNodeList& pNodeList, NodeValueList& pValues)
+{
+    LOGLESS_TRACE();
+    for (auto i = 0u; i < pValues.size() && i < pNodeList.size(); i++)
+    {
+        std::unique_lock<std::mutex> lgTree(mTreeMutex);
+        auto nodeIt = mTree.find(pNodeList[i].uuid);
+        if (mTree.end() == nodeIt)
+        {
+            continue;
+        }
+        auto node = nodeIt->second;
+        lgTree.unlock();
+
+        auto& value = pValues[i];
+        std::unique_lock<std::mutex> lgData(node->dataMutex);
+        if (value.version < node->version)
+        {
+            continue;
+        }
+        node->version = value.version;
+        node->data = std::move(value.data);
+    }
+}
+
 void Client::addNodes(NamedNodeList& pNodeList)
 {
     LOGLESS_TRACE();
@@ -631,6 +1412,7 @@ void Client::addNodes(NamedNodeList& pNodeList)
         {
             auto oldParent = nodeIt->second.get()->parent;
             nodeIt->second.get()->name = i.name;
+            nodeIt->second.get()->type = i.type;
             nodeIt->second.get()->parent = parentIt->second;
 
             std::unique_lock<std::mutex> parentLg(parentNode->childrenMutex);
@@ -650,6 +1432,7 @@ void Client::addNodes(NamedNodeList& pNodeList)
         else
         {
             auto newNode = std::make_shared<Node>(i.name, parentNode, i.uuid);
+            newNode->type = i.type;
             mTree.emplace(i.uuid, newNode);
 
             std::unique_lock<std::mutex> parentLg(parentNode->childrenMutex);
@@ -666,7 +1449,7 @@ void Client::addNodes(NamedNodeList& pNodeList)
     }
 }
 
-uint16_t Client::addTransaction(PropertyTreeProtocol&& pMsg)
+uint16_t Client::addTransaction(PropertyTreeProtocol&& pMsg, std::function<void(RpcPartial&&)> pOnPartial)
 {
     LOGLESS_TRACE();
     uint16_t trId = mTransactioIdCtr.fetch_add(1);
@@ -675,11 +1458,17 @@ uint16_t Client::addTransaction(PropertyTreeProtocol&& pMsg)
         trId = mTransactioIdCtr.fetch_add(1);
     }
 
+    if (!mConnected)
+    {
+        throw std::runtime_error("not connected!");
+    }
+
     auto& message = std::get<PropertyTreeMessage>(pMsg);
     message.transactionId = trId;
 
     std::unique_lock<std::mutex> lg(mTransactionsMutex);
-    mTransactions.emplace(std::piecewise_construct, std::forward_as_tuple(trId), std::forward_as_tuple());
+    auto& transaction = mTransactions.emplace(std::piecewise_construct, std::forward_as_tuple(trId), std::forward_as_tuple()).first->second;
+    transaction.onPartial = std::move(pOnPartial);
 
     send(std::move(pMsg));
 
@@ -698,12 +1487,24 @@ PropertyTreeMessages Client::waitTransaction(uint16_t pTrId)
     {
         std::unique_lock<std::mutex> lg(transaction.mutex);
 
-        transaction.cv.wait_for(lg, std::chrono::milliseconds(500), [this, &transaction](){
+        // Note: A streaming call keeps waiting as long as partials arrive.
+        uint64_t progress = 0;
+        while (!transaction.cv.wait_for(lg, mConfig.transactionTimeout, [&transaction](){
                 return transaction.satisfied;
-            });
+            }))
+        {
+            if (progress == transaction.progress)
+            {
+                break;
+            }
+            progress = transaction.progress;
+        }
 
         if (!transaction.satisfied)
         {
+            lg.unlock();
+            std::unique_lock<std::mutex> lgTransactions(mTransactionsMutex);
+            mTransactions.erase(pTrId);
             throw std::runtime_error("transaction failure");
         }
 
@@ -3,7 +3,10 @@
 
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <mutex>
 #include <unordered_map>
 
@@ -23,6 +26,78 @@ struct ClientConfig
 {
     std::string ip;
     uint16_t port;
+    // rpcWorkers: threads running the rpc handlers, zero runs them on the reactor thread
+    unsigned rpcWorkers = 0;
+    // transactionTimeout: how long a request waits for its response and a streaming rpc handler for a window,
+    //                     keep it above the server's rpcTimeout
+    std::chrono::milliseconds transactionTimeout{500};
+};
+
+class Client;
+
+// RpcResponder: completes one incoming call, copies share the call and only the first completion
+//               is sent. The call is rejected with NO_HANDLER when the last copy goes uncompleted.
+//               Calls have to be completed before the Client is destroyed.
+class RpcResponder
+{
+public:
+    // Note: Sends a partial result of a streaming call, waits for the caller to grant a window.
+    //       Returns false when the call doesn't stream, is completed or the window stays closed
+    //       for transactionTimeout.
+    //       It must not be called from the reactor thread, which delivers the window.
+    bool partial(const std::vector<uint8_t>& pValue);
+    void accept(const std::vector<uint8_t>& pValue);
+    void reject(Cause pCause);
+
+private:
+    friend class Client;
+
+    struct Call
+    {
+        Call(Client& pClient, uint16_t pTransactionId, uint64_t pCallId, uint32_t pWindow)
+            : client(pClient)
+            , transactionId(pTransactionId)
+            , callId(pCallId)
+            , streaming(pWindow)
+            , credit(pWindow)
+        {}
+        ~Call();
+
+        Client& client;
+        uint16_t transactionId;
+        uint64_t callId;
+        bool streaming;
+        std::atomic_bool completed{};
+
+        uint32_t credit;
+        std::mutex creditMutex;
+        std::condition_variable creditCv;
+    };
+
+    RpcResponder(Client& pClient, uint16_t pTransactionId, uint64_t pCallId, uint32_t pWindow);
+
+    std::shared_ptr<Call> mCall;
+};
+
+// NodeTemplate: entry of a pre-order subtree description for Client::create
+struct NodeTemplate
+{
+    // ROOT: parent value that refers to the Property the template is created under
+    static constexpr uint32_t ROOT = 0xFFFFFFFF;
+    std::string name;
+    uint32_t parent = ROOT;
+    std::vector<uint8_t> data;
+    ValueType type = ValueType::NONE;
+};
+
+// QueryResult: node matched by Client::query, path is relative to the queried node
+struct QueryResult
+{
+    std::string path;
+    uint64_t uuid;
+    ValueType type;
+    uint64_t version = 0;
+    std::vector<uint8_t> data;
 };
 
 struct Transaction
@@ -31,6 +106,9 @@ struct Transaction
     PropertyTreeMessages message;
     std::condition_variable cv;
     std::mutex mutex;
+    // onPartial: receives the RpcPartial frames of a streaming call, each one extends the wait
+    std::function<void(RpcPartial&&)> onPartial;
+    uint64_t progress = 0;
 };
 
 class Client
@@ -40,21 +118,43 @@ public:
     ~Client();
 
     Property root();
-    Property create(Property& pParent, const std::string& pName);
-    Property get(Property& pParent, const std::string& pName, bool pRecursive);
-    void commit(Property& pProp);
+    Property create(Property& pParent, const std::string& pName, bool pEphemeral = false, ValueType pType = ValueType::NONE);
+    std::vector<Property> create(Property& pParent, const std::vector<NodeTemplate>& pTemplate);
+    Property aggregate(Property& pParent, const std::string& pName, Property& pSource, AggregateFunction pFunction, const std::string& pPattern);
+    Property get(Property& pParent, const std::string& pName, bool pRecursive, bool pWithValue = false);
+    std::vector<QueryResult> query(Property& pRoot, const std::string& pPattern, bool pWithValue = false);
+    bool commit(Property& pProp);
     void fetch(Property& pProp);
     bool subscribe(Property&);
     bool unsubscribe(Property&);
-    bool destroy(Property&);
+    std::vector<bool> subscribe(std::vector<Property>&);
+    std::vector<bool> unsubscribe(std::vector<Property>&);
+    bool registerProvider(Property&);
+    bool unregisterProvider(Property&);
+    bool destroy(Property&, bool pRecursive);
     void beat();
+    // Note: Reattaches to the session after a disconnect. Returns false when the session could not
+    //       be resumed and a new one was signed in, the local tree and subscriptions are stale then.
+    bool resume();
+    bool connected() const;
+    // Note: Drops the connection only, the session stays on the server for its grace period.
+    void disconnect();
     std::vector<uint8_t> call(Property&, const bfc::BufferView& pValue);
+    std::vector<uint8_t> stream(Property&, const bfc::BufferView& pValue,
+        std::function<void(std::vector<uint8_t>&&)> pOnPartial, uint32_t pWindow);
 
     void setTreeAddHandler(std::function<void(Property)> pHandler);
     void setTreeRemoveHandler(std::function<void(Property)> pHandler);
 
 private:
+    friend class RpcResponder;
+
+    void connect();
+    void signin();
+    void advanceSequence(uint64_t pSequence);
     void send(PropertyTreeProtocol&& pMsg);
+    void sendRpcResponse(PropertyTreeProtocol&& pMsg);
+    void runRpcWorker();
 
     void handle(PropertyTreeMessage&& pMsg);
     void handle(PropertyTreeMessageArray&& pMsg);
@@ -64,18 +164,26 @@ private:
     void handle(uint16_t pTrId, TreeUpdateNotification&& pMsg);
     void handle(uint16_t pTrId, UpdateNotification&& pMsg);
     void handle(uint16_t pTrId, RpcRequest&& pMsg);
+    void handle(uint16_t pTrId, HearbeatRequest&& pMsg);
+    void handle(uint16_t pTrId, RpcCredit&& pMsg);
 
     void removeNodes(const std::vector<uint64_t>& pNodes);
     void addNodes(NamedNodeList& pNodeList);
+    void setValues(NamedNodeList& pNodeList, NodeValueList& pValues);
     
     void handleRead();
     void decodeMessage();
 
-    uint16_t addTransaction(PropertyTreeProtocol&& pMsg);
+    uint16_t addTransaction(PropertyTreeProtocol&& pMsg, std::function<void(RpcPartial&&)> pOnPartial = {});
     PropertyTreeMessages waitTransaction(uint16_t pTrId);
 
     bfc::EpollReactor mReactor;
-    int mFd;
+    ClientConfig mConfig;
+    int mFd = -1;
+    std::atomic_bool mConnected{};
+    uint64_t mToken = 0;
+    // mSequence: server sequence up to which every relevant change was received
+    std::atomic_uint64_t mSequence{};
 
     std::byte mBuff[1024*64];
     uint16_t mBuffIdx = 0;
@@ -92,6 +200,18 @@ private:
 
     std::atomic_uint16_t mTransactioIdCtr{};
 
+    std::mutex mSendMutex;
+
+    // mStreamingCalls: <CallId, Call> incoming streaming calls waiting for RpcCredit
+    std::unordered_map<uint64_t, std::weak_ptr<RpcResponder::Call>> mStreamingCalls;
+    std::mutex mStreamingCallsMutex;
+
+    std::vector<std::thread> mRpcWorkers;
+    std::deque<std::function<void()>> mRpcQueue;
+    std::mutex mRpcQueueMutex;
+    std::condition_variable mRpcQueueCv;
+    bool mRpcStopping = false;
+
     std::function<void(Property)> mTreeAddHandler;
     std::function<void(Property)> mTreeRemoveHandler;
     std::mutex mmTreeHandlerMutex;
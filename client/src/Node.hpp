@@ -7,9 +7,13 @@
 
 #include <logless/Logger.hpp>
 
+#include <interface/protocol.hpp>
+
 namespace propertytree
 {
 
+class RpcResponder;
+
 struct Node
 {
     Node() = delete;
@@ -22,8 +26,13 @@ struct Node
     std::string name;
 
     std::vector<uint8_t> data;
+    uint64_t version = 0;
+    // type: enforced by the server on every commit
+    ValueType type = ValueType::NONE;
     std::map<std::string, std::shared_ptr<Node>> children;
     std::function<std::vector<uint8_t>(const bfc::BufferView&)> rcpHandler;
+    // asyncRpcHandler: completes the call through the responder, possibly later and from another thread
+    std::function<void(const bfc::BufferView&, RpcResponder)> asyncRpcHandler;
     std::function<void()> updateHandler;
  
     std::mutex dataMutex;
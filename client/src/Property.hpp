@@ -23,11 +23,13 @@ public:
         return *this;
     }
 
+    // Note: A value rejected by the server for not matching the node type is rolled back.
     template <typename T>
     Property& operator=(const T& pOther)
     {
         std::unique_lock<std::mutex> lg(mNode->dataMutex);
         auto& node = *mNode;
+        auto previous = node.data;
         if (sizeof(pOther) == node.data.size())
         {
             new (node.data.data()) T(pOther);
@@ -38,18 +40,31 @@ public:
             new (node.data.data()) T(pOther);
         }
 
-        mClient->commit(*this);
+        if (!mClient->commit(*this))
+        {
+            node.data = std::move(previous);
+        }
         return *this;
     }
 
-    void set(std::vector<uint8_t>&& pValue)
+    bool set(std::vector<uint8_t>&& pValue)
     {
         std::unique_lock<std::mutex> lg(mNode->dataMutex);
         auto& node = *mNode;
 
-        node.data = std::move(pValue);
+        std::swap(node.data, pValue);
 
-        mClient->commit(*this);
+        if (!mClient->commit(*this))
+        {
+            std::swap(node.data, pValue);
+            return false;
+        }
+        return true;
+    }
+
+    ValueType type() const
+    {
+        return mNode->type;
     }
 
     template <typename T>
@@ -69,14 +84,40 @@ public:
         return mNode->data;
     }
 
+    uint64_t version()
+    {
+        std::unique_lock<std::mutex> lg(mNode->dataMutex);
+        return mNode->version;
+    }
+
     void fetch()
     {
         mClient->fetch(*this);
     }
 
-    Property create(const std::string& pName)
+    // Note: Ephemeral nodes are removed by the server when this client's session ends and can't have children.
+    //       A typed node only accepts values of that type, NONE accepts anything.
+    Property create(const std::string& pName, bool pEphemeral = false, ValueType pType = ValueType::NONE)
+    {
+        return mClient->create(*this, pName, pEphemeral, pType);
+    }
+
+    std::vector<Property> create(const std::vector<NodeTemplate>& pTemplate)
+    {
+        return mClient->create(*this, pTemplate);
+    }
+
+    // Note: The aggregate is kept up to date by the server over the typed numeric children of pSource
+    //       matching pPattern, it is read-only and removed with this client's session.
+    Property aggregate(const std::string& pName, Property& pSource, AggregateFunction pFunction, const std::string& pPattern = "")
     {
-        return mClient->create(*this, pName);
+        return mClient->aggregate(*this, pName, pSource, pFunction, pPattern);
+    }
+
+    // Note: pPattern is a '/' separated path of globs relative to this node, "**" spans any number of levels.
+    std::vector<QueryResult> query(const std::string& pPattern, bool pWithValue = false)
+    {
+        return mClient->query(*this, pPattern, pWithValue);
     }
 
     Property createOrGet(const std::string& pName)
@@ -109,14 +150,25 @@ public:
         mClient->unsubscribe(*this);
     }
 
-    bool destroy()
+    // Note: Registered providers share the calls made on this node, the least loaded one is picked.
+    bool registerProvider()
+    {
+        return mClient->registerProvider(*this);
+    }
+
+    bool unregisterProvider()
+    {
+        return mClient->unregisterProvider(*this);
+    }
+
+    bool destroy(bool pRecursive = false)
     {
-        return mClient->destroy(*this);
+        return mClient->destroy(*this, pRecursive);
     }
 
-    void loadChildren(bool pRecursive = false)
+    void loadChildren(bool pRecursive = false, bool pWithValue = false)
     {
-        mClient->get(*this, ".", pRecursive);
+        mClient->get(*this, ".", pRecursive, pWithValue);
     }
 
     std::vector<std::pair<std::string, Property>> children()
@@ -141,12 +193,28 @@ public:
         return mClient->call(*this, pValue);
     }
 
+    // Note: pOnPartial runs on the reactor thread for every partial result as it arrives and must not
+    //       call back into the client, at most pWindow of them are in flight. The final value is returned.
+    std::vector<uint8_t> stream(const bfc::BufferView& pValue, std::function<void(std::vector<uint8_t>&&)> pOnPartial,
+        uint32_t pWindow = 16)
+    {
+        return mClient->stream(*this, pValue, std::move(pOnPartial), pWindow);
+    }
+
     void setHRcpHandler(std::function<std::vector<uint8_t>(const bfc::BufferView&)>&& pHandler)
     {
         std::unique_lock<std::mutex> lgRpcHanlder(mNode->rcpHandlerMutex);
         mNode->rcpHandler = std::move(pHandler);
     }
 
+    // Note: pParam is only valid during the call, the handler returns right away and completes the
+    //       call through the responder when the result is ready.
+    void setAsyncRpcHandler(std::function<void(const bfc::BufferView&, RpcResponder)>&& pHandler)
+    {
+        std::unique_lock<std::mutex> lgRpcHanlder(mNode->rcpHandlerMutex);
+        mNode->asyncRpcHandler = std::move(pHandler);
+    }
+
     uint64_t uuid()
     {
         return mNode->uuid;
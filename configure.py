@@ -158,10 +158,12 @@ e2e_test.target_executable('e2e_test')
 
 server_test = Build()
 server_test.set_cxxflags(CXXFLAGS)
-server_test.add_include_paths(['gtest/', './'])
-server_test.set_src_dir('server/tests/')
+server_test.add_include_paths(['gtest/', './', 'server/include/'])
+server_test.add_include_paths(includePathsCommon)
+server_test.set_src_dir('server/test/')
 server_test.add_src_files(SERVER_TEST_SOURCES)
 server_test.add_dependencies(['gtest.a', 'server.a'])
+server_test.add_external_dependencies(['Logless/build/logless.a'])
 server_test.set_linkflags('-lpthread')
 server_test.target_executable('server_test')
 
@@ -18,28 +18,101 @@
 // Enumeration:  ('Cause', ('NOT_PERMITTED', None))
 // Enumeration:  ('Cause', ('NOT_EMPTY', None))
 // Enumeration:  ('Cause', ('NO_HANDLER', None))
+// Enumeration:  ('Cause', ('EXPIRED', None))
+// Enumeration:  ('Cause', ('TIMEOUT', None))
+// Enumeration:  ('Cause', ('BUSY', None))
+// Enumeration:  ('Cause', ('TYPE_MISMATCH', None))
+// Enumeration:  ('Cause', ('TOO_LARGE', None))
+// Enumeration:  ('ValueType', ('NONE', None))
+// Enumeration:  ('ValueType', ('BOOL', None))
+// Enumeration:  ('ValueType', ('I8', None))
+// Enumeration:  ('ValueType', ('I16', None))
+// Enumeration:  ('ValueType', ('I32', None))
+// Enumeration:  ('ValueType', ('I64', None))
+// Enumeration:  ('ValueType', ('U8', None))
+// Enumeration:  ('ValueType', ('U16', None))
+// Enumeration:  ('ValueType', ('U32', None))
+// Enumeration:  ('ValueType', ('U64', None))
+// Enumeration:  ('ValueType', ('F32', None))
+// Enumeration:  ('ValueType', ('F64', None))
+// Enumeration:  ('ValueType', ('STRING', None))
+// Enumeration:  ('ValueType', ('BYTES', None))
+// Type:  ('CauseList', {'type': 'Cause'})
+// Type:  ('CauseList', {'dynamic_array': ''})
 // Sequence:  NamedNode ('String', 'name')
 // Sequence:  NamedNode ('u64', 'uuid')
 // Sequence:  NamedNode ('u64', 'parentUuid')
+// Sequence:  NamedNode ('ValueType', 'type')
 // Type:  ('NamedNodeList', {'type': 'NamedNode'})
 // Type:  ('NamedNodeList', {'dynamic_array': ''})
+// Sequence:  NodeValue ('u64', 'version')
+// Sequence:  NodeValue ('Buffer', 'data')
+// Type:  ('NodeValueList', {'type': 'NodeValue'})
+// Type:  ('NodeValueList', {'dynamic_array': ''})
 // Sequence:  SigninRequest ('u8', 'spare')
 // Sequence:  SigninAccept ('u32', 'sessionId')
+// Sequence:  SigninAccept ('u64', 'token')
+// Sequence:  SigninAccept ('u64', 'sequence')
+// Sequence:  ResumeRequest ('u64', 'token')
+// Sequence:  ResumeRequest ('u64', 'sequence')
+// Sequence:  ResumeAccept ('u64', 'sequence')
+// Sequence:  ResumeReject ('Cause', 'cause')
 // Sequence:  CreateRequest ('String', 'name')
 // Sequence:  CreateRequest ('u64', 'parentUuid')
+// Sequence:  CreateRequest ('u8', 'ephemeral')
+// Sequence:  CreateRequest ('ValueType', 'type')
 // Sequence:  CreateAccept ('u64', 'uuid')
 // Sequence:  CreateReject ('Cause', 'cause')
+// Sequence:  TemplateNode ('String', 'name')
+// Sequence:  TemplateNode ('u32', 'parentIndex')
+// Sequence:  TemplateNode ('Buffer', 'data')
+// Sequence:  TemplateNode ('ValueType', 'type')
+// Type:  ('TemplateNodeList', {'type': 'TemplateNode'})
+// Type:  ('TemplateNodeList', {'dynamic_array': ''})
+// Sequence:  BulkCreateRequest ('u64', 'parentUuid')
+// Sequence:  BulkCreateRequest ('TemplateNodeList', 'nodes')
+// Sequence:  BulkCreateAccept ('u64Array', 'uuids')
+// Sequence:  BulkCreateReject ('Cause', 'cause')
+// Enumeration:  ('AggregateFunction', ('SUM', None))
+// Enumeration:  ('AggregateFunction', ('COUNT', None))
+// Enumeration:  ('AggregateFunction', ('MIN', None))
+// Enumeration:  ('AggregateFunction', ('MAX', None))
+// Sequence:  AggregateCreateRequest ('String', 'name')
+// Sequence:  AggregateCreateRequest ('u64', 'parentUuid')
+// Sequence:  AggregateCreateRequest ('u64', 'sourceUuid')
+// Sequence:  AggregateCreateRequest ('String', 'pattern')
+// Sequence:  AggregateCreateRequest ('AggregateFunction', 'function')
 // Sequence:  GetRequest ('u64', 'uuid')
+// Sequence:  GetAccept ('u64', 'version')
 // Sequence:  GetAccept ('Buffer', 'data')
 // Sequence:  GetReject ('Cause', 'cause')
 // Sequence:  TreeInfoRequest ('u64', 'parentUuid')
 // Sequence:  TreeInfoRequest ('String', 'name')
 // Sequence:  TreeInfoRequest ('u8', 'recursive')
+// Sequence:  TreeInfoRequest ('u64', 'continuation')
+// Sequence:  TreeInfoRequest ('u8', 'withValue')
 // Sequence:  TreeInfoResponse ('NamedNodeList', 'nodeToAddList')
+// Sequence:  TreeInfoResponse ('u64', 'continuation')
+// Sequence:  TreeInfoResponse ('NodeValueList', 'values')
 // Sequence:  TreeInfoErrorResponse ('Cause', 'cause')
+// Sequence:  QueryRequest ('u64', 'rootUuid')
+// Sequence:  QueryRequest ('String', 'pattern')
+// Sequence:  QueryRequest ('u8', 'withValue')
+// Sequence:  QueryRequest ('u64', 'continuation')
+// Sequence:  QueryMatch ('String', 'path')
+// Sequence:  QueryMatch ('u64', 'uuid')
+// Sequence:  QueryMatch ('ValueType', 'type')
+// Type:  ('QueryMatchList', {'type': 'QueryMatch'})
+// Type:  ('QueryMatchList', {'dynamic_array': ''})
+// Sequence:  QueryResponse ('QueryMatchList', 'matches')
+// Sequence:  QueryResponse ('NodeValueList', 'values')
+// Sequence:  QueryResponse ('u64', 'continuation')
+// Sequence:  QueryReject ('Cause', 'cause')
 // Sequence:  TreeUpdateNotification ('NamedNodeList', 'nodeToAddList')
 // Sequence:  TreeUpdateNotification ('u64Array', 'nodeToDelete')
+// Sequence:  TreeUpdateNotification ('u64', 'sequence')
 // Sequence:  DeleteRequest ('u64', 'uuid')
+// Sequence:  DeleteRequest ('u8', 'recursive')
 // Sequence:  DeleteResponse ('Cause', 'cause')
 // Sequence:  SetValueRequest ('u64', 'uuid')
 // Sequence:  SetValueRequest ('Buffer', 'data')
@@ -47,14 +120,39 @@
 // Sequence:  SetValueReject ('Cause', 'cause')
 // Sequence:  SubscribeRequest ('u64', 'uuid')
 // Sequence:  SubscribeResponse ('Cause', 'cause')
+// Sequence:  SubscribeResponse ('u64', 'version')
+// Sequence:  SubscribeResponse ('Buffer', 'data')
 // Sequence:  UnsubscribeRequest ('u64', 'uuid')
 // Sequence:  UnsubscribeResponse ('Cause', 'cause')
+// Sequence:  SubscribeResult ('Cause', 'cause')
+// Sequence:  SubscribeResult ('u64', 'version')
+// Sequence:  SubscribeResult ('Buffer', 'data')
+// Type:  ('SubscribeResultList', {'type': 'SubscribeResult'})
+// Type:  ('SubscribeResultList', {'dynamic_array': ''})
+// Sequence:  BulkSubscribeRequest ('u64Array', 'uuids')
+// Sequence:  BulkSubscribeResponse ('SubscribeResultList', 'results')
+// Sequence:  BulkUnsubscribeRequest ('u64Array', 'uuids')
+// Sequence:  BulkUnsubscribeResponse ('CauseList', 'causes')
 // Sequence:  UpdateNotification ('u64', 'uuid')
+// Sequence:  UpdateNotification ('u64', 'version')
 // Sequence:  UpdateNotification ('Buffer', 'data')
+// Sequence:  UpdateNotification ('u64', 'sequence')
 // Sequence:  RpcRequest ('u64', 'uuid')
 // Sequence:  RpcRequest ('Buffer', 'param')
+// Sequence:  RpcRequest ('u64', 'callId')
+// Sequence:  RpcRequest ('u32', 'window')
 // Sequence:  RpcAccept ('Buffer', 'value')
+// Sequence:  RpcAccept ('u64', 'callId')
 // Sequence:  RpcReject ('Cause', 'cause')
+// Sequence:  RpcReject ('u64', 'callId')
+// Sequence:  RpcPartial ('u64', 'callId')
+// Sequence:  RpcPartial ('Buffer', 'value')
+// Sequence:  RpcCredit ('u64', 'callId')
+// Sequence:  RpcCredit ('u32', 'credit')
+// Sequence:  ProviderRegisterRequest ('u64', 'uuid')
+// Sequence:  ProviderRegisterResponse ('Cause', 'cause')
+// Sequence:  ProviderUnregisterRequest ('u64', 'uuid')
+// Sequence:  ProviderUnregisterResponse ('Cause', 'cause')
 // Sequence:  HearbeatRequest ('u8', 'spare')
 // Sequence:  HearbeatResponse ('u8', 'spare')
 // Choice:  ('PropertyTreeMessages', 'SigninRequest')
@@ -84,6 +182,26 @@
 // Choice:  ('PropertyTreeMessages', 'RpcReject')
 // Choice:  ('PropertyTreeMessages', 'HearbeatRequest')
 // Choice:  ('PropertyTreeMessages', 'HearbeatResponse')
+// Choice:  ('PropertyTreeMessages', 'BulkSubscribeRequest')
+// Choice:  ('PropertyTreeMessages', 'BulkSubscribeResponse')
+// Choice:  ('PropertyTreeMessages', 'BulkUnsubscribeRequest')
+// Choice:  ('PropertyTreeMessages', 'BulkUnsubscribeResponse')
+// Choice:  ('PropertyTreeMessages', 'BulkCreateRequest')
+// Choice:  ('PropertyTreeMessages', 'BulkCreateAccept')
+// Choice:  ('PropertyTreeMessages', 'BulkCreateReject')
+// Choice:  ('PropertyTreeMessages', 'ResumeRequest')
+// Choice:  ('PropertyTreeMessages', 'ResumeAccept')
+// Choice:  ('PropertyTreeMessages', 'ResumeReject')
+// Choice:  ('PropertyTreeMessages', 'ProviderRegisterRequest')
+// Choice:  ('PropertyTreeMessages', 'ProviderRegisterResponse')
+// Choice:  ('PropertyTreeMessages', 'ProviderUnregisterRequest')
+// Choice:  ('PropertyTreeMessages', 'ProviderUnregisterResponse')
+// Choice:  ('PropertyTreeMessages', 'RpcPartial')
+// Choice:  ('PropertyTreeMessages', 'RpcCredit')
+// Choice:  ('PropertyTreeMessages', 'AggregateCreateRequest')
+// Choice:  ('PropertyTreeMessages', 'QueryRequest')
+// Choice:  ('PropertyTreeMessages', 'QueryResponse')
+// Choice:  ('PropertyTreeMessages', 'QueryReject')
 // Sequence:  PropertyTreeMessage ('u16', 'transactionId')
 // Sequence:  PropertyTreeMessage ('PropertyTreeMessages', 'message')
 // Type:  ('PropertyTreeMessageArray', {'type': 'PropertyTreeMessage'})
@@ -116,17 +234,49 @@ enum class Cause : uint8_t
     ALREADY_EXIST,
     NOT_PERMITTED,
     NOT_EMPTY,
-    NO_HANDLER
+    NO_HANDLER,
+    EXPIRED,
+    TIMEOUT,
+    BUSY,
+    TYPE_MISMATCH,
+    TOO_LARGE
 };
 
+enum class ValueType : uint8_t
+{
+    NONE,
+    BOOL,
+    I8,
+    I16,
+    I32,
+    I64,
+    U8,
+    U16,
+    U32,
+    U64,
+    F32,
+    F64,
+    STRING,
+    BYTES
+};
+
+using CauseList = cum::vector<Cause, 4294967296>;
 struct NamedNode
 {
     String name;
     u64 uuid;
     u64 parentUuid;
+    ValueType type;
 };
 
 using NamedNodeList = cum::vector<NamedNode, 4294967296>;
+struct NodeValue
+{
+    u64 version;
+    Buffer data;
+};
+
+using NodeValueList = cum::vector<NodeValue, 4294967296>;
 struct SigninRequest
 {
     u8 spare;
@@ -135,12 +285,32 @@ struct SigninRequest
 struct SigninAccept
 {
     u32 sessionId;
+    u64 token;
+    u64 sequence;
+};
+
+struct ResumeRequest
+{
+    u64 token;
+    u64 sequence;
+};
+
+struct ResumeAccept
+{
+    u64 sequence;
+};
+
+struct ResumeReject
+{
+    Cause cause;
 };
 
 struct CreateRequest
 {
     String name;
     u64 parentUuid;
+    u8 ephemeral;
+    ValueType type;
 };
 
 struct CreateAccept
@@ -153,6 +323,48 @@ struct CreateReject
     Cause cause;
 };
 
+struct TemplateNode
+{
+    String name;
+    u32 parentIndex;
+    Buffer data;
+    ValueType type;
+};
+
+using TemplateNodeList = cum::vector<TemplateNode, 4294967296>;
+struct BulkCreateRequest
+{
+    u64 parentUuid;
+    TemplateNodeList nodes;
+};
+
+struct BulkCreateAccept
+{
+    u64Array uuids;
+};
+
+struct BulkCreateReject
+{
+    Cause cause;
+};
+
+enum class AggregateFunction : uint8_t
+{
+    SUM,
+    COUNT,
+    MIN,
+    MAX
+};
+
+struct AggregateCreateRequest
+{
+    String name;
+    u64 parentUuid;
+    u64 sourceUuid;
+    String pattern;
+    AggregateFunction function;
+};
+
 struct GetRequest
 {
     u64 uuid;
@@ -160,6 +372,7 @@ struct GetRequest
 
 struct GetAccept
 {
+    u64 version;
     Buffer data;
 };
 
@@ -173,11 +386,15 @@ struct TreeInfoRequest
     u64 parentUuid;
     String name;
     u8 recursive;
+    u64 continuation;
+    u8 withValue;
 };
 
 struct TreeInfoResponse
 {
     NamedNodeList nodeToAddList;
+    u64 continuation;
+    NodeValueList values;
 };
 
 struct TreeInfoErrorResponse
@@ -185,15 +402,45 @@ struct TreeInfoErrorResponse
     Cause cause;
 };
 
+struct QueryRequest
+{
+    u64 rootUuid;
+    String pattern;
+    u8 withValue;
+    u64 continuation;
+};
+
+struct QueryMatch
+{
+    String path;
+    u64 uuid;
+    ValueType type;
+};
+
+using QueryMatchList = cum::vector<QueryMatch, 4294967296>;
+struct QueryResponse
+{
+    QueryMatchList matches;
+    NodeValueList values;
+    u64 continuation;
+};
+
+struct QueryReject
+{
+    Cause cause;
+};
+
 struct TreeUpdateNotification
 {
     NamedNodeList nodeToAddList;
     u64Array nodeToDelete;
+    u64 sequence;
 };
 
 struct DeleteRequest
 {
     u64 uuid;
+    u8 recursive;
 };
 
 struct DeleteResponse
@@ -225,6 +472,8 @@ struct SubscribeRequest
 struct SubscribeResponse
 {
     Cause cause;
+    u64 version;
+    Buffer data;
 };
 
 struct UnsubscribeRequest
@@ -237,24 +486,90 @@ struct UnsubscribeResponse
     Cause cause;
 };
 
+struct SubscribeResult
+{
+    Cause cause;
+    u64 version;
+    Buffer data;
+};
+
+using SubscribeResultList = cum::vector<SubscribeResult, 4294967296>;
+struct BulkSubscribeRequest
+{
+    u64Array uuids;
+};
+
+struct BulkSubscribeResponse
+{
+    SubscribeResultList results;
+};
+
+struct BulkUnsubscribeRequest
+{
+    u64Array uuids;
+};
+
+struct BulkUnsubscribeResponse
+{
+    CauseList causes;
+};
+
 struct UpdateNotification
 {
     u64 uuid;
+    u64 version;
     Buffer data;
+    u64 sequence;
 };
 
 struct RpcRequest
 {
     u64 uuid;
     Buffer param;
+    u64 callId;
+    u32 window;
 };
 
 struct RpcAccept
 {
     Buffer value;
+    u64 callId;
 };
 
 struct RpcReject
+{
+    Cause cause;
+    u64 callId;
+};
+
+struct RpcPartial
+{
+    u64 callId;
+    Buffer value;
+};
+
+struct RpcCredit
+{
+    u64 callId;
+    u32 credit;
+};
+
+struct ProviderRegisterRequest
+{
+    u64 uuid;
+};
+
+struct ProviderRegisterResponse
+{
+    Cause cause;
+};
+
+struct ProviderUnregisterRequest
+{
+    u64 uuid;
+};
+
+struct ProviderUnregisterResponse
 {
     Cause cause;
 };
@@ -269,7 +584,7 @@ struct HearbeatResponse
     u8 spare;
 };
 
-using PropertyTreeMessages = std::variant<SigninRequest,SigninAccept,CreateRequest,CreateAccept,CreateReject,GetRequest,GetAccept,GetReject,TreeInfoRequest,TreeInfoResponse,TreeInfoErrorResponse,TreeUpdateNotification,DeleteRequest,DeleteResponse,SetValueRequest,SetValueAccept,SetValueReject,SubscribeRequest,SubscribeResponse,UnsubscribeRequest,UnsubscribeResponse,UpdateNotification,RpcRequest,RpcAccept,RpcReject,HearbeatRequest,HearbeatResponse>;
+using PropertyTreeMessages = std::variant<SigninRequest,SigninAccept,CreateRequest,CreateAccept,CreateReject,GetRequest,GetAccept,GetReject,TreeInfoRequest,TreeInfoResponse,TreeInfoErrorResponse,TreeUpdateNotification,DeleteRequest,DeleteResponse,SetValueRequest,SetValueAccept,SetValueReject,SubscribeRequest,SubscribeResponse,UnsubscribeRequest,UnsubscribeResponse,UpdateNotification,RpcRequest,RpcAccept,RpcReject,HearbeatRequest,HearbeatResponse,BulkSubscribeRequest,BulkSubscribeResponse,BulkUnsubscribeRequest,BulkUnsubscribeResponse,BulkCreateRequest,BulkCreateAccept,BulkCreateReject,ResumeRequest,ResumeAccept,ResumeReject,ProviderRegisterRequest,ProviderRegisterResponse,ProviderUnregisterRequest,ProviderUnregisterResponse,RpcPartial,RpcCredit,AggregateCreateRequest,QueryRequest,QueryResponse,QueryReject>;
 struct PropertyTreeMessage
 {
     u16 transactionId;
@@ -297,6 +612,39 @@ inline void str(const char* pName, const Cause& pIe, std::string& pCtx, bool pIs
     if (Cause::NOT_PERMITTED == pIe) pCtx += "\"NOT_PERMITTED\"";
     if (Cause::NOT_EMPTY == pIe) pCtx += "\"NOT_EMPTY\"";
     if (Cause::NO_HANDLER == pIe) pCtx += "\"NO_HANDLER\"";
+    if (Cause::EXPIRED == pIe) pCtx += "\"EXPIRED\"";
+    if (Cause::TIMEOUT == pIe) pCtx += "\"TIMEOUT\"";
+    if (Cause::BUSY == pIe) pCtx += "\"BUSY\"";
+    if (Cause::TYPE_MISMATCH == pIe) pCtx += "\"TYPE_MISMATCH\"";
+    if (Cause::TOO_LARGE == pIe) pCtx += "\"TOO_LARGE\"";
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void str(const char* pName, const ValueType& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (pName)
+    {
+        pCtx = pCtx + "\"" + pName + "\":";
+    }
+    if (ValueType::NONE == pIe) pCtx += "\"NONE\"";
+    if (ValueType::BOOL == pIe) pCtx += "\"BOOL\"";
+    if (ValueType::I8 == pIe) pCtx += "\"I8\"";
+    if (ValueType::I16 == pIe) pCtx += "\"I16\"";
+    if (ValueType::I32 == pIe) pCtx += "\"I32\"";
+    if (ValueType::I64 == pIe) pCtx += "\"I64\"";
+    if (ValueType::U8 == pIe) pCtx += "\"U8\"";
+    if (ValueType::U16 == pIe) pCtx += "\"U16\"";
+    if (ValueType::U32 == pIe) pCtx += "\"U32\"";
+    if (ValueType::U64 == pIe) pCtx += "\"U64\"";
+    if (ValueType::F32 == pIe) pCtx += "\"F32\"";
+    if (ValueType::F64 == pIe) pCtx += "\"F64\"";
+    if (ValueType::STRING == pIe) pCtx += "\"STRING\"";
+    if (ValueType::BYTES == pIe) pCtx += "\"BYTES\"";
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -310,6 +658,7 @@ inline void encode_per(const NamedNode& pIe, cum::per_codec_ctx& pCtx)
     encode_per(pIe.name, pCtx);
     encode_per(pIe.uuid, pCtx);
     encode_per(pIe.parentUuid, pCtx);
+    encode_per(pIe.type, pCtx);
 }
 
 inline void decode_per(NamedNode& pIe, cum::per_codec_ctx& pCtx)
@@ -318,6 +667,7 @@ inline void decode_per(NamedNode& pIe, cum::per_codec_ctx& pCtx)
     decode_per(pIe.name, pCtx);
     decode_per(pIe.uuid, pCtx);
     decode_per(pIe.parentUuid, pCtx);
+    decode_per(pIe.type, pCtx);
 }
 
 inline void str(const char* pName, const NamedNode& pIe, std::string& pCtx, bool pIsLast)
@@ -332,10 +682,47 @@ inline void str(const char* pName, const NamedNode& pIe, std::string& pCtx, bool
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 3;
+    size_t nMandatory = 4;
     str("name", pIe.name, pCtx, !(--nMandatory+nOptional));
     str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
     str("parentUuid", pIe.parentUuid, pCtx, !(--nMandatory+nOptional));
+    str("type", pIe.type, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const NodeValue& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.version, pCtx);
+    encode_per(pIe.data, pCtx);
+}
+
+inline void decode_per(NodeValue& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.version, pCtx);
+    decode_per(pIe.data, pCtx);
+}
+
+inline void str(const char* pName, const NodeValue& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 2;
+    str("version", pIe.version, pCtx, !(--nMandatory+nOptional));
+    str("data", pIe.data, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -380,12 +767,16 @@ inline void encode_per(const SigninAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     encode_per(pIe.sessionId, pCtx);
+    encode_per(pIe.token, pCtx);
+    encode_per(pIe.sequence, pCtx);
 }
 
 inline void decode_per(SigninAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     decode_per(pIe.sessionId, pCtx);
+    decode_per(pIe.token, pCtx);
+    decode_per(pIe.sequence, pCtx);
 }
 
 inline void str(const char* pName, const SigninAccept& pIe, std::string& pCtx, bool pIsLast)
@@ -400,8 +791,10 @@ inline void str(const char* pName, const SigninAccept& pIe, std::string& pCtx, b
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 1;
+    size_t nMandatory = 3;
     str("sessionId", pIe.sessionId, pCtx, !(--nMandatory+nOptional));
+    str("token", pIe.token, pCtx, !(--nMandatory+nOptional));
+    str("sequence", pIe.sequence, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -409,21 +802,21 @@ inline void str(const char* pName, const SigninAccept& pIe, std::string& pCtx, b
     }
 }
 
-inline void encode_per(const CreateRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const ResumeRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.name, pCtx);
-    encode_per(pIe.parentUuid, pCtx);
+    encode_per(pIe.token, pCtx);
+    encode_per(pIe.sequence, pCtx);
 }
 
-inline void decode_per(CreateRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(ResumeRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.name, pCtx);
-    decode_per(pIe.parentUuid, pCtx);
+    decode_per(pIe.token, pCtx);
+    decode_per(pIe.sequence, pCtx);
 }
 
-inline void str(const char* pName, const CreateRequest& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const ResumeRequest& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -436,8 +829,8 @@ inline void str(const char* pName, const CreateRequest& pIe, std::string& pCtx,
     }
     size_t nOptional = 0;
     size_t nMandatory = 2;
-    str("name", pIe.name, pCtx, !(--nMandatory+nOptional));
-    str("parentUuid", pIe.parentUuid, pCtx, !(--nMandatory+nOptional));
+    str("token", pIe.token, pCtx, !(--nMandatory+nOptional));
+    str("sequence", pIe.sequence, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -445,19 +838,19 @@ inline void str(const char* pName, const CreateRequest& pIe, std::string& pCtx,
     }
 }
 
-inline void encode_per(const CreateAccept& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const ResumeAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.uuid, pCtx);
+    encode_per(pIe.sequence, pCtx);
 }
 
-inline void decode_per(CreateAccept& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(ResumeAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.uuid, pCtx);
+    decode_per(pIe.sequence, pCtx);
 }
 
-inline void str(const char* pName, const CreateAccept& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const ResumeAccept& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -470,7 +863,7 @@ inline void str(const char* pName, const CreateAccept& pIe, std::string& pCtx, b
     }
     size_t nOptional = 0;
     size_t nMandatory = 1;
-    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    str("sequence", pIe.sequence, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -478,19 +871,19 @@ inline void str(const char* pName, const CreateAccept& pIe, std::string& pCtx, b
     }
 }
 
-inline void encode_per(const CreateReject& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const ResumeReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     encode_per(pIe.cause, pCtx);
 }
 
-inline void decode_per(CreateReject& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(ResumeReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     decode_per(pIe.cause, pCtx);
 }
 
-inline void str(const char* pName, const CreateReject& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const ResumeReject& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -511,19 +904,25 @@ inline void str(const char* pName, const CreateReject& pIe, std::string& pCtx, b
     }
 }
 
-inline void encode_per(const GetRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const CreateRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.uuid, pCtx);
+    encode_per(pIe.name, pCtx);
+    encode_per(pIe.parentUuid, pCtx);
+    encode_per(pIe.ephemeral, pCtx);
+    encode_per(pIe.type, pCtx);
 }
 
-inline void decode_per(GetRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(CreateRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.uuid, pCtx);
+    decode_per(pIe.name, pCtx);
+    decode_per(pIe.parentUuid, pCtx);
+    decode_per(pIe.ephemeral, pCtx);
+    decode_per(pIe.type, pCtx);
 }
 
-inline void str(const char* pName, const GetRequest& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const CreateRequest& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -535,8 +934,11 @@ inline void str(const char* pName, const GetRequest& pIe, std::string& pCtx, boo
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 1;
-    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    size_t nMandatory = 4;
+    str("name", pIe.name, pCtx, !(--nMandatory+nOptional));
+    str("parentUuid", pIe.parentUuid, pCtx, !(--nMandatory+nOptional));
+    str("ephemeral", pIe.ephemeral, pCtx, !(--nMandatory+nOptional));
+    str("type", pIe.type, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -544,19 +946,19 @@ inline void str(const char* pName, const GetRequest& pIe, std::string& pCtx, boo
     }
 }
 
-inline void encode_per(const GetAccept& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const CreateAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.data, pCtx);
+    encode_per(pIe.uuid, pCtx);
 }
 
-inline void decode_per(GetAccept& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(CreateAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.data, pCtx);
+    decode_per(pIe.uuid, pCtx);
 }
 
-inline void str(const char* pName, const GetAccept& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const CreateAccept& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -569,7 +971,7 @@ inline void str(const char* pName, const GetAccept& pIe, std::string& pCtx, bool
     }
     size_t nOptional = 0;
     size_t nMandatory = 1;
-    str("data", pIe.data, pCtx, !(--nMandatory+nOptional));
+    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -577,19 +979,19 @@ inline void str(const char* pName, const GetAccept& pIe, std::string& pCtx, bool
     }
 }
 
-inline void encode_per(const GetReject& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const CreateReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     encode_per(pIe.cause, pCtx);
 }
 
-inline void decode_per(GetReject& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(CreateReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     decode_per(pIe.cause, pCtx);
 }
 
-inline void str(const char* pName, const GetReject& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const CreateReject& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -610,23 +1012,25 @@ inline void str(const char* pName, const GetReject& pIe, std::string& pCtx, bool
     }
 }
 
-inline void encode_per(const TreeInfoRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const TemplateNode& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.parentUuid, pCtx);
     encode_per(pIe.name, pCtx);
-    encode_per(pIe.recursive, pCtx);
+    encode_per(pIe.parentIndex, pCtx);
+    encode_per(pIe.data, pCtx);
+    encode_per(pIe.type, pCtx);
 }
 
-inline void decode_per(TreeInfoRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(TemplateNode& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.parentUuid, pCtx);
     decode_per(pIe.name, pCtx);
-    decode_per(pIe.recursive, pCtx);
+    decode_per(pIe.parentIndex, pCtx);
+    decode_per(pIe.data, pCtx);
+    decode_per(pIe.type, pCtx);
 }
 
-inline void str(const char* pName, const TreeInfoRequest& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const TemplateNode& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -638,10 +1042,11 @@ inline void str(const char* pName, const TreeInfoRequest& pIe, std::string& pCtx
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 3;
-    str("parentUuid", pIe.parentUuid, pCtx, !(--nMandatory+nOptional));
+    size_t nMandatory = 4;
     str("name", pIe.name, pCtx, !(--nMandatory+nOptional));
-    str("recursive", pIe.recursive, pCtx, !(--nMandatory+nOptional));
+    str("parentIndex", pIe.parentIndex, pCtx, !(--nMandatory+nOptional));
+    str("data", pIe.data, pCtx, !(--nMandatory+nOptional));
+    str("type", pIe.type, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -649,19 +1054,21 @@ inline void str(const char* pName, const TreeInfoRequest& pIe, std::string& pCtx
     }
 }
 
-inline void encode_per(const TreeInfoResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const BulkCreateRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.nodeToAddList, pCtx);
+    encode_per(pIe.parentUuid, pCtx);
+    encode_per(pIe.nodes, pCtx);
 }
 
-inline void decode_per(TreeInfoResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(BulkCreateRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.nodeToAddList, pCtx);
+    decode_per(pIe.parentUuid, pCtx);
+    decode_per(pIe.nodes, pCtx);
 }
 
-inline void str(const char* pName, const TreeInfoResponse& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const BulkCreateRequest& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -673,8 +1080,9 @@ inline void str(const char* pName, const TreeInfoResponse& pIe, std::string& pCt
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 1;
-    str("nodeToAddList", pIe.nodeToAddList, pCtx, !(--nMandatory+nOptional));
+    size_t nMandatory = 2;
+    str("parentUuid", pIe.parentUuid, pCtx, !(--nMandatory+nOptional));
+    str("nodes", pIe.nodes, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -682,19 +1090,19 @@ inline void str(const char* pName, const TreeInfoResponse& pIe, std::string& pCt
     }
 }
 
-inline void encode_per(const TreeInfoErrorResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const BulkCreateAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.cause, pCtx);
+    encode_per(pIe.uuids, pCtx);
 }
 
-inline void decode_per(TreeInfoErrorResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(BulkCreateAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.cause, pCtx);
+    decode_per(pIe.uuids, pCtx);
 }
 
-inline void str(const char* pName, const TreeInfoErrorResponse& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const BulkCreateAccept& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -707,7 +1115,7 @@ inline void str(const char* pName, const TreeInfoErrorResponse& pIe, std::string
     }
     size_t nOptional = 0;
     size_t nMandatory = 1;
-    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
+    str("uuids", pIe.uuids, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -715,21 +1123,19 @@ inline void str(const char* pName, const TreeInfoErrorResponse& pIe, std::string
     }
 }
 
-inline void encode_per(const TreeUpdateNotification& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const BulkCreateReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.nodeToAddList, pCtx);
-    encode_per(pIe.nodeToDelete, pCtx);
+    encode_per(pIe.cause, pCtx);
 }
 
-inline void decode_per(TreeUpdateNotification& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(BulkCreateReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.nodeToAddList, pCtx);
-    decode_per(pIe.nodeToDelete, pCtx);
+    decode_per(pIe.cause, pCtx);
 }
 
-inline void str(const char* pName, const TreeUpdateNotification& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const BulkCreateReject& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -741,9 +1147,8 @@ inline void str(const char* pName, const TreeUpdateNotification& pIe, std::strin
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 2;
-    str("nodeToAddList", pIe.nodeToAddList, pCtx, !(--nMandatory+nOptional));
-    str("nodeToDelete", pIe.nodeToDelete, pCtx, !(--nMandatory+nOptional));
+    size_t nMandatory = 1;
+    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -751,23 +1156,49 @@ inline void str(const char* pName, const TreeUpdateNotification& pIe, std::strin
     }
 }
 
-inline void encode_per(const DeleteRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void str(const char* pName, const AggregateFunction& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
-    encode_per(pIe.uuid, pCtx);
+    if (pName)
+    {
+        pCtx = pCtx + "\"" + pName + "\":";
+    }
+    if (AggregateFunction::SUM == pIe) pCtx += "\"SUM\"";
+    if (AggregateFunction::COUNT == pIe) pCtx += "\"COUNT\"";
+    if (AggregateFunction::MIN == pIe) pCtx += "\"MIN\"";
+    if (AggregateFunction::MAX == pIe) pCtx += "\"MAX\"";
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
 }
 
-inline void decode_per(DeleteRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const AggregateCreateRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.uuid, pCtx);
+    encode_per(pIe.name, pCtx);
+    encode_per(pIe.parentUuid, pCtx);
+    encode_per(pIe.sourceUuid, pCtx);
+    encode_per(pIe.pattern, pCtx);
+    encode_per(pIe.function, pCtx);
 }
 
-inline void str(const char* pName, const DeleteRequest& pIe, std::string& pCtx, bool pIsLast)
+inline void decode_per(AggregateCreateRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    if (!pName)
-    {
+    decode_per(pIe.name, pCtx);
+    decode_per(pIe.parentUuid, pCtx);
+    decode_per(pIe.sourceUuid, pCtx);
+    decode_per(pIe.pattern, pCtx);
+    decode_per(pIe.function, pCtx);
+}
+
+inline void str(const char* pName, const AggregateCreateRequest& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
         pCtx = pCtx + "{";
     }
     else
@@ -775,8 +1206,12 @@ inline void str(const char* pName, const DeleteRequest& pIe, std::string& pCtx,
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 1;
-    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    size_t nMandatory = 5;
+    str("name", pIe.name, pCtx, !(--nMandatory+nOptional));
+    str("parentUuid", pIe.parentUuid, pCtx, !(--nMandatory+nOptional));
+    str("sourceUuid", pIe.sourceUuid, pCtx, !(--nMandatory+nOptional));
+    str("pattern", pIe.pattern, pCtx, !(--nMandatory+nOptional));
+    str("function", pIe.function, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -784,19 +1219,19 @@ inline void str(const char* pName, const DeleteRequest& pIe, std::string& pCtx,
     }
 }
 
-inline void encode_per(const DeleteResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const GetRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.cause, pCtx);
+    encode_per(pIe.uuid, pCtx);
 }
 
-inline void decode_per(DeleteResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(GetRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.cause, pCtx);
+    decode_per(pIe.uuid, pCtx);
 }
 
-inline void str(const char* pName, const DeleteResponse& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const GetRequest& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -809,7 +1244,7 @@ inline void str(const char* pName, const DeleteResponse& pIe, std::string& pCtx,
     }
     size_t nOptional = 0;
     size_t nMandatory = 1;
-    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
+    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -817,21 +1252,21 @@ inline void str(const char* pName, const DeleteResponse& pIe, std::string& pCtx,
     }
 }
 
-inline void encode_per(const SetValueRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const GetAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.uuid, pCtx);
+    encode_per(pIe.version, pCtx);
     encode_per(pIe.data, pCtx);
 }
 
-inline void decode_per(SetValueRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(GetAccept& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.uuid, pCtx);
+    decode_per(pIe.version, pCtx);
     decode_per(pIe.data, pCtx);
 }
 
-inline void str(const char* pName, const SetValueRequest& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const GetAccept& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -844,7 +1279,7 @@ inline void str(const char* pName, const SetValueRequest& pIe, std::string& pCtx
     }
     size_t nOptional = 0;
     size_t nMandatory = 2;
-    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    str("version", pIe.version, pCtx, !(--nMandatory+nOptional));
     str("data", pIe.data, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
@@ -853,19 +1288,19 @@ inline void str(const char* pName, const SetValueRequest& pIe, std::string& pCtx
     }
 }
 
-inline void encode_per(const SetValueAccept& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const GetReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.spare, pCtx);
+    encode_per(pIe.cause, pCtx);
 }
 
-inline void decode_per(SetValueAccept& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(GetReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.spare, pCtx);
+    decode_per(pIe.cause, pCtx);
 }
 
-inline void str(const char* pName, const SetValueAccept& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const GetReject& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -878,7 +1313,7 @@ inline void str(const char* pName, const SetValueAccept& pIe, std::string& pCtx,
     }
     size_t nOptional = 0;
     size_t nMandatory = 1;
-    str("spare", pIe.spare, pCtx, !(--nMandatory+nOptional));
+    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -886,19 +1321,103 @@ inline void str(const char* pName, const SetValueAccept& pIe, std::string& pCtx,
     }
 }
 
-inline void encode_per(const SetValueReject& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const TreeInfoRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.parentUuid, pCtx);
+    encode_per(pIe.name, pCtx);
+    encode_per(pIe.recursive, pCtx);
+    encode_per(pIe.continuation, pCtx);
+    encode_per(pIe.withValue, pCtx);
+}
+
+inline void decode_per(TreeInfoRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.parentUuid, pCtx);
+    decode_per(pIe.name, pCtx);
+    decode_per(pIe.recursive, pCtx);
+    decode_per(pIe.continuation, pCtx);
+    decode_per(pIe.withValue, pCtx);
+}
+
+inline void str(const char* pName, const TreeInfoRequest& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 5;
+    str("parentUuid", pIe.parentUuid, pCtx, !(--nMandatory+nOptional));
+    str("name", pIe.name, pCtx, !(--nMandatory+nOptional));
+    str("recursive", pIe.recursive, pCtx, !(--nMandatory+nOptional));
+    str("continuation", pIe.continuation, pCtx, !(--nMandatory+nOptional));
+    str("withValue", pIe.withValue, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const TreeInfoResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.nodeToAddList, pCtx);
+    encode_per(pIe.continuation, pCtx);
+    encode_per(pIe.values, pCtx);
+}
+
+inline void decode_per(TreeInfoResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.nodeToAddList, pCtx);
+    decode_per(pIe.continuation, pCtx);
+    decode_per(pIe.values, pCtx);
+}
+
+inline void str(const char* pName, const TreeInfoResponse& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 3;
+    str("nodeToAddList", pIe.nodeToAddList, pCtx, !(--nMandatory+nOptional));
+    str("continuation", pIe.continuation, pCtx, !(--nMandatory+nOptional));
+    str("values", pIe.values, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const TreeInfoErrorResponse& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     encode_per(pIe.cause, pCtx);
 }
 
-inline void decode_per(SetValueReject& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(TreeInfoErrorResponse& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     decode_per(pIe.cause, pCtx);
 }
 
-inline void str(const char* pName, const SetValueReject& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const TreeInfoErrorResponse& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -919,19 +1438,65 @@ inline void str(const char* pName, const SetValueReject& pIe, std::string& pCtx,
     }
 }
 
-inline void encode_per(const SubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const QueryRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.rootUuid, pCtx);
+    encode_per(pIe.pattern, pCtx);
+    encode_per(pIe.withValue, pCtx);
+    encode_per(pIe.continuation, pCtx);
+}
+
+inline void decode_per(QueryRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.rootUuid, pCtx);
+    decode_per(pIe.pattern, pCtx);
+    decode_per(pIe.withValue, pCtx);
+    decode_per(pIe.continuation, pCtx);
+}
+
+inline void str(const char* pName, const QueryRequest& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 4;
+    str("rootUuid", pIe.rootUuid, pCtx, !(--nMandatory+nOptional));
+    str("pattern", pIe.pattern, pCtx, !(--nMandatory+nOptional));
+    str("withValue", pIe.withValue, pCtx, !(--nMandatory+nOptional));
+    str("continuation", pIe.continuation, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const QueryMatch& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
+    encode_per(pIe.path, pCtx);
     encode_per(pIe.uuid, pCtx);
+    encode_per(pIe.type, pCtx);
 }
 
-inline void decode_per(SubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(QueryMatch& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
+    decode_per(pIe.path, pCtx);
     decode_per(pIe.uuid, pCtx);
+    decode_per(pIe.type, pCtx);
 }
 
-inline void str(const char* pName, const SubscribeRequest& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const QueryMatch& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -943,8 +1508,10 @@ inline void str(const char* pName, const SubscribeRequest& pIe, std::string& pCt
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 1;
+    size_t nMandatory = 3;
+    str("path", pIe.path, pCtx, !(--nMandatory+nOptional));
     str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    str("type", pIe.type, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -952,19 +1519,58 @@ inline void str(const char* pName, const SubscribeRequest& pIe, std::string& pCt
     }
 }
 
-inline void encode_per(const SubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const QueryResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.matches, pCtx);
+    encode_per(pIe.values, pCtx);
+    encode_per(pIe.continuation, pCtx);
+}
+
+inline void decode_per(QueryResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.matches, pCtx);
+    decode_per(pIe.values, pCtx);
+    decode_per(pIe.continuation, pCtx);
+}
+
+inline void str(const char* pName, const QueryResponse& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 3;
+    str("matches", pIe.matches, pCtx, !(--nMandatory+nOptional));
+    str("values", pIe.values, pCtx, !(--nMandatory+nOptional));
+    str("continuation", pIe.continuation, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const QueryReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     encode_per(pIe.cause, pCtx);
 }
 
-inline void decode_per(SubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(QueryReject& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     decode_per(pIe.cause, pCtx);
 }
 
-inline void str(const char* pName, const SubscribeResponse& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const QueryReject& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -985,19 +1591,60 @@ inline void str(const char* pName, const SubscribeResponse& pIe, std::string& pC
     }
 }
 
-inline void encode_per(const UnsubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const TreeUpdateNotification& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.nodeToAddList, pCtx);
+    encode_per(pIe.nodeToDelete, pCtx);
+    encode_per(pIe.sequence, pCtx);
+}
+
+inline void decode_per(TreeUpdateNotification& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.nodeToAddList, pCtx);
+    decode_per(pIe.nodeToDelete, pCtx);
+    decode_per(pIe.sequence, pCtx);
+}
+
+inline void str(const char* pName, const TreeUpdateNotification& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 3;
+    str("nodeToAddList", pIe.nodeToAddList, pCtx, !(--nMandatory+nOptional));
+    str("nodeToDelete", pIe.nodeToDelete, pCtx, !(--nMandatory+nOptional));
+    str("sequence", pIe.sequence, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const DeleteRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     encode_per(pIe.uuid, pCtx);
+    encode_per(pIe.recursive, pCtx);
 }
 
-inline void decode_per(UnsubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(DeleteRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     decode_per(pIe.uuid, pCtx);
+    decode_per(pIe.recursive, pCtx);
 }
 
-inline void str(const char* pName, const UnsubscribeRequest& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const DeleteRequest& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -1009,8 +1656,9 @@ inline void str(const char* pName, const UnsubscribeRequest& pIe, std::string& p
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 1;
+    size_t nMandatory = 2;
     str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    str("recursive", pIe.recursive, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -1018,19 +1666,19 @@ inline void str(const char* pName, const UnsubscribeRequest& pIe, std::string& p
     }
 }
 
-inline void encode_per(const UnsubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const DeleteResponse& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     encode_per(pIe.cause, pCtx);
 }
 
-inline void decode_per(UnsubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(DeleteResponse& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     decode_per(pIe.cause, pCtx);
 }
 
-inline void str(const char* pName, const UnsubscribeResponse& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const DeleteResponse& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -1051,21 +1699,658 @@ inline void str(const char* pName, const UnsubscribeResponse& pIe, std::string&
     }
 }
 
-inline void encode_per(const UpdateNotification& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const SetValueRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.uuid, pCtx);
+    encode_per(pIe.data, pCtx);
+}
+
+inline void decode_per(SetValueRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.uuid, pCtx);
+    decode_per(pIe.data, pCtx);
+}
+
+inline void str(const char* pName, const SetValueRequest& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 2;
+    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    str("data", pIe.data, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const SetValueAccept& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.spare, pCtx);
+}
+
+inline void decode_per(SetValueAccept& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.spare, pCtx);
+}
+
+inline void str(const char* pName, const SetValueAccept& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 1;
+    str("spare", pIe.spare, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const SetValueReject& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.cause, pCtx);
+}
+
+inline void decode_per(SetValueReject& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.cause, pCtx);
+}
+
+inline void str(const char* pName, const SetValueReject& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 1;
+    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const SubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.uuid, pCtx);
+}
+
+inline void decode_per(SubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.uuid, pCtx);
+}
+
+inline void str(const char* pName, const SubscribeRequest& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 1;
+    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const SubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.cause, pCtx);
+    encode_per(pIe.version, pCtx);
+    encode_per(pIe.data, pCtx);
+}
+
+inline void decode_per(SubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.cause, pCtx);
+    decode_per(pIe.version, pCtx);
+    decode_per(pIe.data, pCtx);
+}
+
+inline void str(const char* pName, const SubscribeResponse& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 3;
+    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
+    str("version", pIe.version, pCtx, !(--nMandatory+nOptional));
+    str("data", pIe.data, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const UnsubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.uuid, pCtx);
+}
+
+inline void decode_per(UnsubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.uuid, pCtx);
+}
+
+inline void str(const char* pName, const UnsubscribeRequest& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 1;
+    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const UnsubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.cause, pCtx);
+}
+
+inline void decode_per(UnsubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.cause, pCtx);
+}
+
+inline void str(const char* pName, const UnsubscribeResponse& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 1;
+    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const SubscribeResult& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.cause, pCtx);
+    encode_per(pIe.version, pCtx);
+    encode_per(pIe.data, pCtx);
+}
+
+inline void decode_per(SubscribeResult& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.cause, pCtx);
+    decode_per(pIe.version, pCtx);
+    decode_per(pIe.data, pCtx);
+}
+
+inline void str(const char* pName, const SubscribeResult& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 3;
+    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
+    str("version", pIe.version, pCtx, !(--nMandatory+nOptional));
+    str("data", pIe.data, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const BulkSubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.uuids, pCtx);
+}
+
+inline void decode_per(BulkSubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.uuids, pCtx);
+}
+
+inline void str(const char* pName, const BulkSubscribeRequest& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 1;
+    str("uuids", pIe.uuids, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const BulkSubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.results, pCtx);
+}
+
+inline void decode_per(BulkSubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.results, pCtx);
+}
+
+inline void str(const char* pName, const BulkSubscribeResponse& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 1;
+    str("results", pIe.results, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const BulkUnsubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.uuids, pCtx);
+}
+
+inline void decode_per(BulkUnsubscribeRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.uuids, pCtx);
+}
+
+inline void str(const char* pName, const BulkUnsubscribeRequest& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 1;
+    str("uuids", pIe.uuids, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const BulkUnsubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.causes, pCtx);
+}
+
+inline void decode_per(BulkUnsubscribeResponse& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.causes, pCtx);
+}
+
+inline void str(const char* pName, const BulkUnsubscribeResponse& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 1;
+    str("causes", pIe.causes, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const UpdateNotification& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.uuid, pCtx);
+    encode_per(pIe.version, pCtx);
+    encode_per(pIe.data, pCtx);
+    encode_per(pIe.sequence, pCtx);
+}
+
+inline void decode_per(UpdateNotification& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.uuid, pCtx);
+    decode_per(pIe.version, pCtx);
+    decode_per(pIe.data, pCtx);
+    decode_per(pIe.sequence, pCtx);
+}
+
+inline void str(const char* pName, const UpdateNotification& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 4;
+    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    str("version", pIe.version, pCtx, !(--nMandatory+nOptional));
+    str("data", pIe.data, pCtx, !(--nMandatory+nOptional));
+    str("sequence", pIe.sequence, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const RpcRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.uuid, pCtx);
+    encode_per(pIe.param, pCtx);
+    encode_per(pIe.callId, pCtx);
+    encode_per(pIe.window, pCtx);
+}
+
+inline void decode_per(RpcRequest& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.uuid, pCtx);
+    decode_per(pIe.param, pCtx);
+    decode_per(pIe.callId, pCtx);
+    decode_per(pIe.window, pCtx);
+}
+
+inline void str(const char* pName, const RpcRequest& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 4;
+    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
+    str("param", pIe.param, pCtx, !(--nMandatory+nOptional));
+    str("callId", pIe.callId, pCtx, !(--nMandatory+nOptional));
+    str("window", pIe.window, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const RpcAccept& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.value, pCtx);
+    encode_per(pIe.callId, pCtx);
+}
+
+inline void decode_per(RpcAccept& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.value, pCtx);
+    decode_per(pIe.callId, pCtx);
+}
+
+inline void str(const char* pName, const RpcAccept& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 2;
+    str("value", pIe.value, pCtx, !(--nMandatory+nOptional));
+    str("callId", pIe.callId, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const RpcReject& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.cause, pCtx);
+    encode_per(pIe.callId, pCtx);
+}
+
+inline void decode_per(RpcReject& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.cause, pCtx);
+    decode_per(pIe.callId, pCtx);
+}
+
+inline void str(const char* pName, const RpcReject& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 2;
+    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
+    str("callId", pIe.callId, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const RpcPartial& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.callId, pCtx);
+    encode_per(pIe.value, pCtx);
+}
+
+inline void decode_per(RpcPartial& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.callId, pCtx);
+    decode_per(pIe.value, pCtx);
+}
+
+inline void str(const char* pName, const RpcPartial& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 2;
+    str("callId", pIe.callId, pCtx, !(--nMandatory+nOptional));
+    str("value", pIe.value, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const RpcCredit& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    encode_per(pIe.callId, pCtx);
+    encode_per(pIe.credit, pCtx);
+}
+
+inline void decode_per(RpcCredit& pIe, cum::per_codec_ctx& pCtx)
+{
+    using namespace cum;
+    decode_per(pIe.callId, pCtx);
+    decode_per(pIe.credit, pCtx);
+}
+
+inline void str(const char* pName, const RpcCredit& pIe, std::string& pCtx, bool pIsLast)
+{
+    using namespace cum;
+    if (!pName)
+    {
+        pCtx = pCtx + "{";
+    }
+    else
+    {
+        pCtx = pCtx + "\"" + pName + "\":{";
+    }
+    size_t nOptional = 0;
+    size_t nMandatory = 2;
+    str("callId", pIe.callId, pCtx, !(--nMandatory+nOptional));
+    str("credit", pIe.credit, pCtx, !(--nMandatory+nOptional));
+    pCtx = pCtx + "}";
+    if (!pIsLast)
+    {
+        pCtx += ",";
+    }
+}
+
+inline void encode_per(const ProviderRegisterRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     encode_per(pIe.uuid, pCtx);
-    encode_per(pIe.data, pCtx);
 }
 
-inline void decode_per(UpdateNotification& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(ProviderRegisterRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     decode_per(pIe.uuid, pCtx);
-    decode_per(pIe.data, pCtx);
 }
 
-inline void str(const char* pName, const UpdateNotification& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const ProviderRegisterRequest& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -1077,9 +2362,8 @@ inline void str(const char* pName, const UpdateNotification& pIe, std::string& p
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 2;
+    size_t nMandatory = 1;
     str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
-    str("data", pIe.data, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -1087,21 +2371,19 @@ inline void str(const char* pName, const UpdateNotification& pIe, std::string& p
     }
 }
 
-inline void encode_per(const RpcRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const ProviderRegisterResponse& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.uuid, pCtx);
-    encode_per(pIe.param, pCtx);
+    encode_per(pIe.cause, pCtx);
 }
 
-inline void decode_per(RpcRequest& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(ProviderRegisterResponse& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.uuid, pCtx);
-    decode_per(pIe.param, pCtx);
+    decode_per(pIe.cause, pCtx);
 }
 
-inline void str(const char* pName, const RpcRequest& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const ProviderRegisterResponse& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -1113,9 +2395,8 @@ inline void str(const char* pName, const RpcRequest& pIe, std::string& pCtx, boo
         pCtx = pCtx + "\"" + pName + "\":{";
     }
     size_t nOptional = 0;
-    size_t nMandatory = 2;
-    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
-    str("param", pIe.param, pCtx, !(--nMandatory+nOptional));
+    size_t nMandatory = 1;
+    str("cause", pIe.cause, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -1123,19 +2404,19 @@ inline void str(const char* pName, const RpcRequest& pIe, std::string& pCtx, boo
     }
 }
 
-inline void encode_per(const RpcAccept& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const ProviderUnregisterRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    encode_per(pIe.value, pCtx);
+    encode_per(pIe.uuid, pCtx);
 }
 
-inline void decode_per(RpcAccept& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(ProviderUnregisterRequest& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
-    decode_per(pIe.value, pCtx);
+    decode_per(pIe.uuid, pCtx);
 }
 
-inline void str(const char* pName, const RpcAccept& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const ProviderUnregisterRequest& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -1148,7 +2429,7 @@ inline void str(const char* pName, const RpcAccept& pIe, std::string& pCtx, bool
     }
     size_t nOptional = 0;
     size_t nMandatory = 1;
-    str("value", pIe.value, pCtx, !(--nMandatory+nOptional));
+    str("uuid", pIe.uuid, pCtx, !(--nMandatory+nOptional));
     pCtx = pCtx + "}";
     if (!pIsLast)
     {
@@ -1156,19 +2437,19 @@ inline void str(const char* pName, const RpcAccept& pIe, std::string& pCtx, bool
     }
 }
 
-inline void encode_per(const RpcReject& pIe, cum::per_codec_ctx& pCtx)
+inline void encode_per(const ProviderUnregisterResponse& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     encode_per(pIe.cause, pCtx);
 }
 
-inline void decode_per(RpcReject& pIe, cum::per_codec_ctx& pCtx)
+inline void decode_per(ProviderUnregisterResponse& pIe, cum::per_codec_ctx& pCtx)
 {
     using namespace cum;
     decode_per(pIe.cause, pCtx);
 }
 
-inline void str(const char* pName, const RpcReject& pIe, std::string& pCtx, bool pIsLast)
+inline void str(const char* pName, const ProviderUnregisterResponse& pIe, std::string& pCtx, bool pIsLast)
 {
     using namespace cum;
     if (!pName)
@@ -1369,6 +2650,86 @@ inline void encode_per(const PropertyTreeMessages& pIe, cum::per_codec_ctx& pCtx
     {
         encode_per(std::get<26>(pIe), pCtx);
     }
+    else if (27 == type)
+    {
+        encode_per(std::get<27>(pIe), pCtx);
+    }
+    else if (28 == type)
+    {
+        encode_per(std::get<28>(pIe), pCtx);
+    }
+    else if (29 == type)
+    {
+        encode_per(std::get<29>(pIe), pCtx);
+    }
+    else if (30 == type)
+    {
+        encode_per(std::get<30>(pIe), pCtx);
+    }
+    else if (31 == type)
+    {
+        encode_per(std::get<31>(pIe), pCtx);
+    }
+    else if (32 == type)
+    {
+        encode_per(std::get<32>(pIe), pCtx);
+    }
+    else if (33 == type)
+    {
+        encode_per(std::get<33>(pIe), pCtx);
+    }
+    else if (34 == type)
+    {
+        encode_per(std::get<34>(pIe), pCtx);
+    }
+    else if (35 == type)
+    {
+        encode_per(std::get<35>(pIe), pCtx);
+    }
+    else if (36 == type)
+    {
+        encode_per(std::get<36>(pIe), pCtx);
+    }
+    else if (37 == type)
+    {
+        encode_per(std::get<37>(pIe), pCtx);
+    }
+    else if (38 == type)
+    {
+        encode_per(std::get<38>(pIe), pCtx);
+    }
+    else if (39 == type)
+    {
+        encode_per(std::get<39>(pIe), pCtx);
+    }
+    else if (40 == type)
+    {
+        encode_per(std::get<40>(pIe), pCtx);
+    }
+    else if (41 == type)
+    {
+        encode_per(std::get<41>(pIe), pCtx);
+    }
+    else if (42 == type)
+    {
+        encode_per(std::get<42>(pIe), pCtx);
+    }
+    else if (43 == type)
+    {
+        encode_per(std::get<43>(pIe), pCtx);
+    }
+    else if (44 == type)
+    {
+        encode_per(std::get<44>(pIe), pCtx);
+    }
+    else if (45 == type)
+    {
+        encode_per(std::get<45>(pIe), pCtx);
+    }
+    else if (46 == type)
+    {
+        encode_per(std::get<46>(pIe), pCtx);
+    }
 }
 
 inline void decode_per(PropertyTreeMessages& pIe, cum::per_codec_ctx& pCtx)
@@ -1512,6 +2873,106 @@ inline void decode_per(PropertyTreeMessages& pIe, cum::per_codec_ctx& pCtx)
         pIe = HearbeatResponse();
         decode_per(std::get<26>(pIe), pCtx);
     }
+    else if (27 == type)
+    {
+        pIe = BulkSubscribeRequest();
+        decode_per(std::get<27>(pIe), pCtx);
+    }
+    else if (28 == type)
+    {
+        pIe = BulkSubscribeResponse();
+        decode_per(std::get<28>(pIe), pCtx);
+    }
+    else if (29 == type)
+    {
+        pIe = BulkUnsubscribeRequest();
+        decode_per(std::get<29>(pIe), pCtx);
+    }
+    else if (30 == type)
+    {
+        pIe = BulkUnsubscribeResponse();
+        decode_per(std::get<30>(pIe), pCtx);
+    }
+    else if (31 == type)
+    {
+        pIe = BulkCreateRequest();
+        decode_per(std::get<31>(pIe), pCtx);
+    }
+    else if (32 == type)
+    {
+        pIe = BulkCreateAccept();
+        decode_per(std::get<32>(pIe), pCtx);
+    }
+    else if (33 == type)
+    {
+        pIe = BulkCreateReject();
+        decode_per(std::get<33>(pIe), pCtx);
+    }
+    else if (34 == type)
+    {
+        pIe = ResumeRequest();
+        decode_per(std::get<34>(pIe), pCtx);
+    }
+    else if (35 == type)
+    {
+        pIe = ResumeAccept();
+        decode_per(std::get<35>(pIe), pCtx);
+    }
+    else if (36 == type)
+    {
+        pIe = ResumeReject();
+        decode_per(std::get<36>(pIe), pCtx);
+    }
+    else if (37 == type)
+    {
+        pIe = ProviderRegisterRequest();
+        decode_per(std::get<37>(pIe), pCtx);
+    }
+    else if (38 == type)
+    {
+        pIe = ProviderRegisterResponse();
+        decode_per(std::get<38>(pIe), pCtx);
+    }
+    else if (39 == type)
+    {
+        pIe = ProviderUnregisterRequest();
+        decode_per(std::get<39>(pIe), pCtx);
+    }
+    else if (40 == type)
+    {
+        pIe = ProviderUnregisterResponse();
+        decode_per(std::get<40>(pIe), pCtx);
+    }
+    else if (41 == type)
+    {
+        pIe = RpcPartial();
+        decode_per(std::get<41>(pIe), pCtx);
+    }
+    else if (42 == type)
+    {
+        pIe = RpcCredit();
+        decode_per(std::get<42>(pIe), pCtx);
+    }
+    else if (43 == type)
+    {
+        pIe = AggregateCreateRequest();
+        decode_per(std::get<43>(pIe), pCtx);
+    }
+    else if (44 == type)
+    {
+        pIe = QueryRequest();
+        decode_per(std::get<44>(pIe), pCtx);
+    }
+    else if (45 == type)
+    {
+        pIe = QueryResponse();
+        decode_per(std::get<45>(pIe), pCtx);
+    }
+    else if (46 == type)
+    {
+        pIe = QueryReject();
+        decode_per(std::get<46>(pIe), pCtx);
+    }
 }
 
 inline void str(const char* pName, const PropertyTreeMessages& pIe, std::string& pCtx, bool pIsLast)
@@ -1789,6 +3250,206 @@ inline void str(const char* pName, const PropertyTreeMessages& pIe, std::string&
         str(name.c_str(), std::get<26>(pIe), pCtx, true);
         pCtx += "}";
     }
+    else if (27 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "BulkSubscribeRequest";
+        str(name.c_str(), std::get<27>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (28 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "BulkSubscribeResponse";
+        str(name.c_str(), std::get<28>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (29 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "BulkUnsubscribeRequest";
+        str(name.c_str(), std::get<29>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (30 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "BulkUnsubscribeResponse";
+        str(name.c_str(), std::get<30>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (31 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "BulkCreateRequest";
+        str(name.c_str(), std::get<31>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (32 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "BulkCreateAccept";
+        str(name.c_str(), std::get<32>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (33 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "BulkCreateReject";
+        str(name.c_str(), std::get<33>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (34 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "ResumeRequest";
+        str(name.c_str(), std::get<34>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (35 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "ResumeAccept";
+        str(name.c_str(), std::get<35>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (36 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "ResumeReject";
+        str(name.c_str(), std::get<36>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (37 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "ProviderRegisterRequest";
+        str(name.c_str(), std::get<37>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (38 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "ProviderRegisterResponse";
+        str(name.c_str(), std::get<38>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (39 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "ProviderUnregisterRequest";
+        str(name.c_str(), std::get<39>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (40 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "ProviderUnregisterResponse";
+        str(name.c_str(), std::get<40>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (41 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "RpcPartial";
+        str(name.c_str(), std::get<41>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (42 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "RpcCredit";
+        str(name.c_str(), std::get<42>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (43 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "AggregateCreateRequest";
+        str(name.c_str(), std::get<43>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (44 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "QueryRequest";
+        str(name.c_str(), std::get<44>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (45 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "QueryResponse";
+        str(name.c_str(), std::get<45>(pIe), pCtx, true);
+        pCtx += "}";
+    }
+    else if (46 == type)
+    {
+        if (pName)
+            pCtx += std::string(pName) + ":{";
+        else
+            pCtx += "{";
+        std::string name = "QueryReject";
+        str(name.c_str(), std::get<46>(pIe), pCtx, true);
+        pCtx += "}";
+    }
     if (!pIsLast)
     {
         pCtx += ",";
@@ -62,12 +62,12 @@ public:
                     lgToSubscribe.unlock();
                     for (auto& prop : tosub)
                     {
-                        prop.subscribe();
                         prop.setUpdateHandler([this, prop]() mutable {
                                 auto data = prop.raw();
                                 consoleLog("[Monitor]: Property upt uuid=", prop.uuid(), " name=\"", prop.name(), "\" data=[", data.size(), "]{", toHexString(data.data(), data.size()) ,"}");
                             });
                     }
+                    mClient.subscribe(tosub);
                 }
             });
 
@@ -341,7 +341,8 @@ private:
             return "property not found!";
         }
 
-        return prop.destroy() ? "deleted!" : "failed!";
+        auto recursive = pMap.arg("recursive");
+        return prop.destroy(recursive && "true" == *recursive) ? "deleted!" : "failed!";
     }
 
     std::string onCmdAutoWatch(bfc::ArgsMap&& pMap)
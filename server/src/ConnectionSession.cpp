@@ -7,6 +7,10 @@
 namespace propertytree
 {
 
+constexpr unsigned BULK_SKIP_LIMIT = 8;
+constexpr size_t CONGESTION_SIZE = 1024*1024*4;
+// Note: A session that cannot take its notifications this fast is dropped, it can resume later.
+constexpr size_t BULK_QUEUE_LIMIT = 1024*1024*16;
 
 ConnectionSession::ConnectionSession(int pFd, IServer& pServer, ProtocolHandler& pProto)
     : mFd(pFd)
@@ -20,17 +24,167 @@ ConnectionSession::~ConnectionSession()
     close(mFd);
 }
 
-void ConnectionSession::send(const bfc::ConstBufferView& pBuffer)
+void ConnectionSession::send(const bfc::ConstBufferView& pBuffer, Lane pLane)
 {
     Logless("DBG ConnectionSession[_]: send: _", mFd, BufferLog(pBuffer.size(), pBuffer.data()));
-    auto res = ::send(mFd, pBuffer.data(), pBuffer.size(), 0);
-    if (-1 == res)
+    if (mBroken)
     {
-        Logless("ERR ConnectionSession[_]: write error=_", mFd, strerror(errno));
-        // TODO: this causes recursive locking in ProtocolHandler::mSessionsMutex 
-        // mServer.onDisconnect(mFd);
         return;
     }
+
+    auto data = (const std::byte*)pBuffer.data();
+    auto size = pBuffer.size();
+
+    // Note: Fast path, nothing is waiting so the frame goes straight to the socket.
+    if (!mQueuedSize)
+    {
+        auto res = ::send(mFd, data, size, MSG_DONTWAIT);
+        if (-1 == res)
+        {
+            if (EAGAIN != errno && EWOULDBLOCK != errno)
+            {
+                Logless("ERR ConnectionSession[_]: write error=_", mFd, strerror(errno));
+                fail();
+                return;
+            }
+            res = 0;
+        }
+
+        if (size_t(res) == size)
+        {
+            return;
+        }
+
+        mSendingLane = int(pLane);
+        mSendOffset = res;
+    }
+
+    mLanes[size_t(pLane)].emplace_back(data, data + size);
+    mQueuedSize += size;
+
+    if (Lane::BULK == pLane)
+    {
+        mBulkSize += size;
+        if (mBulkSize > BULK_QUEUE_LIMIT)
+        {
+            Logless("ERR ConnectionSession[_]: bulk lane overflow queued=_", mFd, mBulkSize);
+            fail();
+            return;
+        }
+    }
+
+    if (!mCongested && mQueuedSize >= CONGESTION_SIZE)
+    {
+        mCongested = true;
+        Logless("WRN ConnectionSession[_]: congested queued=_", mFd, mQueuedSize);
+    }
+
+    flush();
+}
+
+int ConnectionSession::nextLane()
+{
+    auto& bulk = mLanes[size_t(Lane::BULK)];
+
+    // Note: Bulk traffic still gets a frame through after BULK_SKIP_LIMIT higher priority frames.
+    if (bulk.size() && mBulkSkipCount >= BULK_SKIP_LIMIT)
+    {
+        mBulkSkipCount = 0;
+        return int(Lane::BULK);
+    }
+
+    for (auto lane : {Lane::CONTROL, Lane::RESPONSE})
+    {
+        if (mLanes[size_t(lane)].size())
+        {
+            if (bulk.size())
+            {
+                mBulkSkipCount++;
+            }
+            return int(lane);
+        }
+    }
+
+    if (bulk.size())
+    {
+        mBulkSkipCount = 0;
+        return int(Lane::BULK);
+    }
+
+    return -1;
+}
+
+void ConnectionSession::flush()
+{
+    while (mQueuedSize)
+    {
+        if (-1 == mSendingLane)
+        {
+            mSendingLane = nextLane();
+            mSendOffset = 0;
+        }
+
+        auto& lane = mLanes[mSendingLane];
+        auto& frame = lane.front();
+
+        auto res = ::send(mFd, frame.data() + mSendOffset, frame.size() - mSendOffset, MSG_DONTWAIT);
+        if (-1 == res)
+        {
+            if (EAGAIN != errno && EWOULDBLOCK != errno)
+            {
+                Logless("ERR ConnectionSession[_]: write error=_", mFd, strerror(errno));
+                fail();
+                return;
+            }
+            mServer.onBlocked(mFd);
+            return;
+        }
+
+        mSendOffset += res;
+        if (mSendOffset < frame.size())
+        {
+            mServer.onBlocked(mFd);
+            return;
+        }
+
+        mQueuedSize -= frame.size();
+        if (int(Lane::BULK) == mSendingLane)
+        {
+            mBulkSize -= frame.size();
+        }
+        lane.pop_front();
+        mSendingLane = -1;
+    }
+
+    if (mCongested)
+    {
+        mCongested = false;
+        Logless("INF ConnectionSession[_]: drained", mFd);
+    }
+}
+
+void ConnectionSession::fail()
+{
+    // Note: The owner may still be inside ProtocolHandler, the server disconnects broken sessions later.
+    mBroken = true;
+    for (auto& lane : mLanes)
+    {
+        lane.clear();
+    }
+    mQueuedSize = 0;
+    mBulkSize = 0;
+    mSendingLane = -1;
+}
+
+bool ConnectionSession::broken() const
+{
+    return mBroken;
+}
+
+void ConnectionSession::disconnect()
+{
+    Logless("DBG ConnectionSession[_]: disconnect", mFd);
+    mServer.onDisconnect(mFd);
 }
 
 void ConnectionSession::handleRead()
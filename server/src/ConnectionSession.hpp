@@ -1,7 +1,9 @@
 #ifndef __CONNECTION_SESSION_HPP__
 #define __CONNECTION_SESSION_HPP__
 
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include <logless/Logger.hpp>
 
@@ -22,10 +24,27 @@ public:
     ConnectionSession(int pFd, IServer& pServer, ProtocolHandler& pProto);
     ~ConnectionSession();
     void handleRead();
+    void flush();
+    void disconnect();
+    // broken: true after a hard write error or a bulk lane overflow, the server must disconnect it
+    bool broken() const;
 private:
-    void send(const bfc::ConstBufferView&);
-
-    std::byte mBuff[512];
+    void send(const bfc::ConstBufferView&, Lane);
+    int nextLane();
+    void fail();
+
+    // mLanes: frames waiting for the socket to drain, one queue per Lane
+    std::deque<std::vector<std::byte>> mLanes[size_t(Lane::N_LANES)];
+    size_t mQueuedSize = 0;
+    size_t mBulkSize = 0;
+    // mSendingLane: lane of the partially written front frame, -1 when none
+    int mSendingLane = -1;
+    size_t mSendOffset = 0;
+    unsigned mBulkSkipCount = 0;
+    bool mCongested = false;
+    bool mBroken = false;
+
+    std::byte mBuff[1024*64];
     uint16_t mBuffIdx = 0;
     enum ReadState {WAIT_HEADER, WAIT_REMAINING};
     ReadState mReadState = WAIT_HEADER;
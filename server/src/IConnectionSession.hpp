@@ -11,11 +11,14 @@
 namespace propertytree
 {
 
+// Lane: outbound priority class, CONTROL is sent first and BULK last
+enum class Lane {CONTROL, RESPONSE, BULK, N_LANES};
+
 struct IConnectionSession
 {
     virtual ~IConnectionSession() {}
-    virtual void send(const bfc::ConstBufferView&) = 0;
-    
+    virtual void send(const bfc::ConstBufferView&, Lane) = 0;
+    virtual void disconnect() = 0;
 };
 
 } // propertytree
@@ -7,6 +7,8 @@ namespace propertytree
 struct IServer
 {
     virtual void onDisconnect(int pFd) = 0; 
+    // onBlocked: the socket is full, pFd must be flushed again once it is writable
+    virtual void onBlocked(int pFd) = 0;
 };
 
 } // propertytree
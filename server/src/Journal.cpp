@@ -0,0 +1,302 @@
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include <Journal.hpp>
+
+namespace propertytree
+{
+
+Journal::Journal(const std::string& pPath, std::chrono::milliseconds pSyncPeriod, size_t pSyncSize)
+    : mPath(pPath)
+    , mRotatedPath(pPath + ".old")
+    , mSyncPeriod(pSyncPeriod)
+    , mSyncSize(pSyncSize)
+{
+    mFd = open(mPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (-1 == mFd)
+    {
+        throw std::runtime_error(strerror(errno));
+    }
+
+    mWriter = std::thread([this](){
+            run();
+        });
+}
+
+Journal::~Journal()
+{
+    std::unique_lock<std::mutex> lg(mMutex);
+    mRunning = false;
+    lg.unlock();
+    mCv.notify_one();
+    mWriter.join();
+    if (-1 != mFd)
+    {
+        close(mFd);
+    }
+}
+
+void Journal::append(RecordType pType, uint64_t pSequence, uint64_t pUuid, uint64_t pArg, const void* pData, size_t pSize, uint8_t pValueType)
+{
+    // Note: Records of a failed journal could never be written, they aren't buffered either.
+    if (mFailed)
+    {
+        return;
+    }
+
+    Record record{pSequence, pUuid, pArg, uint32_t(pSize), pType, pValueType, {}};
+
+    std::unique_lock<std::mutex> lg(mMutex);
+    auto offset = mPending.size();
+    mPending.resize(offset + sizeof(record) + pSize);
+    std::memcpy(mPending.data() + offset, &record, sizeof(record));
+    if (pSize)
+    {
+        std::memcpy(mPending.data() + offset + sizeof(record), pData, pSize);
+    }
+    mPendingSequence = pSequence;
+
+    if (mPending.size() >= mSyncSize)
+    {
+        lg.unlock();
+        mCv.notify_one();
+    }
+}
+
+uint64_t Journal::durableSequence() const
+{
+    return mDurableSequence.load();
+}
+
+bool Journal::failed() const
+{
+    return mFailed.load();
+}
+
+void Journal::rotate()
+{
+    std::unique_lock<std::mutex> lg(mMutex);
+    mSealed.insert(mSealed.end(), mPending.begin(), mPending.end());
+    mPending.clear();
+    mRotate = true;
+}
+
+void Journal::release()
+{
+    std::unique_lock<std::mutex> lg(mMutex);
+    mRelease = true;
+}
+
+void Journal::run()
+{
+    // Note: A batch that failed to write is kept and retried ahead of everything appended after it,
+    //       the durable sequence only moves once all of it is written.
+    std::vector<std::byte> sealed;
+    std::vector<std::byte> writing;
+    bool rotate = false;
+    std::unique_lock<std::mutex> lg(mMutex);
+    while (true)
+    {
+        mCv.wait_for(lg, mSyncPeriod, [this](){
+                return !mRunning || mPending.size() >= mSyncSize;
+            });
+
+        bool running = mRunning;
+        bool release = mRelease;
+        auto sequence = mPendingSequence;
+        if (mRotate)
+        {
+            sealed.insert(sealed.end(), writing.begin(), writing.end());
+            sealed.insert(sealed.end(), mSealed.begin(), mSealed.end());
+            writing.clear();
+            rotate = true;
+        }
+        writing.insert(writing.end(), mPending.begin(), mPending.end());
+        mSealed.clear();
+        mPending.clear();
+        mRotate = false;
+        mRelease = false;
+        lg.unlock();
+
+        bool ok = reopen() && write(sealed);
+        if (ok)
+        {
+            sealed.clear();
+        }
+
+        // Note: The rotated file is only replaced while no snapshot needs it, otherwise the
+        //       journal keeps growing and the records already covered are skipped on replay.
+        if (ok && rotate && -1 == access(mRotatedPath.c_str(), F_OK))
+        {
+            if (-1 == rename(mPath.c_str(), mRotatedPath.c_str()))
+            {
+                Logless("ERR Journal: rotate failed errno=\"_\"", strerror(errno));
+            }
+            else
+            {
+                close(mFd);
+                mFd = -1;
+                ok = reopen();
+            }
+        }
+
+        if (ok)
+        {
+            rotate = false;
+        }
+
+        if (release)
+        {
+            unlink(mRotatedPath.c_str());
+        }
+
+        if (ok && write(writing))
+        {
+            writing.clear();
+            mDurableSequence = sequence;
+        }
+        else if (mFailed)
+        {
+            sealed.clear();
+            writing.clear();
+        }
+
+        lg.lock();
+        if (!running)
+        {
+            break;
+        }
+    }
+}
+
+// Note: A file that could not be opened after rotation is opened again on every batch, the records
+//       are kept until it succeeds.
+bool Journal::reopen()
+{
+    if (-1 != mFd)
+    {
+        return true;
+    }
+
+    mFd = open(mPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (-1 == mFd)
+    {
+        Logless("ERR Journal: reopen failed errno=\"_\"", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool Journal::write(const std::vector<std::byte>& pData)
+{
+    if (mFailed || -1 == mFd)
+    {
+        return false;
+    }
+    if (!pData.size())
+    {
+        return true;
+    }
+
+    // Note: A failed batch is cut off again so that its retry doesn't leave a partial copy behind.
+    auto offset = lseek(mFd, 0, SEEK_END);
+    size_t written = 0;
+    while (written < pData.size())
+    {
+        auto res = ::write(mFd, pData.data() + written, pData.size() - written);
+        if (-1 == res)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            Logless("ERR Journal: write failed errno=\"_\"", strerror(errno));
+            truncate(offset);
+            return false;
+        }
+        written += res;
+    }
+
+    if (-1 == fdatasync(mFd))
+    {
+        Logless("ERR Journal: fdatasync failed errno=\"_\"", strerror(errno));
+        truncate(offset);
+        return false;
+    }
+    return true;
+}
+
+void Journal::truncate(off_t pOffset)
+{
+    if (-1 == pOffset || -1 == ftruncate(mFd, pOffset))
+    {
+        // Note: The file may now hold a partial batch, nothing after it can be made durable.
+        Logless("ERR Journal: truncate failed errno=\"_\", journal stopped", strerror(errno));
+        mFailed = true;
+    }
+}
+
+void Journal::replay(const std::string& pPath, std::function<void(const Record&, const uint8_t*)> pHandler)
+{
+    for (auto& path : {pPath + ".old", pPath})
+    {
+        int fd = open(path.c_str(), O_RDWR);
+        if (-1 == fd)
+        {
+            if (ENOENT != errno)
+            {
+                throw std::runtime_error(strerror(errno));
+            }
+            continue;
+        }
+
+        struct stat fileStat;
+        if (-1 == fstat(fd, &fileStat))
+        {
+            close(fd);
+            throw std::runtime_error(strerror(errno));
+        }
+
+        std::vector<std::byte> content(fileStat.st_size);
+        size_t readSize = 0;
+        while (readSize < content.size())
+        {
+            auto res = read(fd, content.data() + readSize, content.size() - readSize);
+            if (0 >= res)
+            {
+                close(fd);
+                throw std::runtime_error("Journal: read failed!");
+            }
+            readSize += res;
+        }
+
+        size_t offset = 0;
+        while (content.size() - offset >= sizeof(Record))
+        {
+            Record record;
+            std::memcpy(&record, content.data() + offset, sizeof(record));
+            if (content.size() - offset - sizeof(record) < record.size)
+            {
+                break;
+            }
+            pHandler(record, (const uint8_t*)content.data() + offset + sizeof(record));
+            offset += sizeof(record) + record.size;
+        }
+
+        if (offset != content.size())
+        {
+            Logless("WRN Journal: dropping torn record at _ offset=_", path.c_str(), offset);
+            if (-1 == ftruncate(fd, offset))
+            {
+                close(fd);
+                throw std::runtime_error(strerror(errno));
+            }
+        }
+        close(fd);
+    }
+}
+
+} // propertytree
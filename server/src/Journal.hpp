@@ -0,0 +1,84 @@
+#ifndef __JOURNAL_HPP__
+#define __JOURNAL_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <logless/Logger.hpp>
+
+namespace propertytree
+{
+
+// Journal: append-only log of tree mutations, written and synced in batches by its own thread
+class Journal
+{
+public:
+    enum class RecordType : uint8_t {CREATE, SET, DELETE};
+
+    // Note: Record is followed by size bytes, the name for CREATE and the data for SET.
+    //       arg holds the parent uuid for CREATE and the version for SET, valueType is only set for CREATE.
+    struct Record
+    {
+        uint64_t sequence;
+        uint64_t uuid;
+        uint64_t arg;
+        uint32_t size;
+        RecordType type;
+        uint8_t valueType;
+        uint8_t reserved[2];
+    };
+
+    Journal(const std::string& pPath, std::chrono::milliseconds pSyncPeriod, size_t pSyncSize);
+    ~Journal();
+
+    void append(RecordType pType, uint64_t pSequence, uint64_t pUuid, uint64_t pArg, const void* pData, size_t pSize, uint8_t pValueType = 0);
+    uint64_t durableSequence() const;
+    // failed: nothing appended can be made durable anymore, the durable sequence stays where it is
+    bool failed() const;
+    // rotate: records appended from now on go to a new file, the previous one is kept until release
+    void rotate();
+    // release: removes the rotated file once a snapshot covers it
+    void release();
+
+    // replay: reads the rotated file then the current one, a torn last record is cut off
+    static void replay(const std::string& pPath, std::function<void(const Record&, const uint8_t*)> pHandler);
+
+private:
+    void run();
+    bool reopen();
+    bool write(const std::vector<std::byte>& pData);
+    void truncate(off_t pOffset);
+
+    std::string mPath;
+    std::string mRotatedPath;
+    std::chrono::milliseconds mSyncPeriod;
+    size_t mSyncSize;
+    int mFd;
+    // mFailed: a failed batch could not be cut off, the journal can't be appended to anymore
+    std::atomic<bool> mFailed{};
+
+    // mSealed: records that belong to the file before a requested rotation
+    std::vector<std::byte> mSealed;
+    std::vector<std::byte> mPending;
+    uint64_t mPendingSequence = 0;
+    bool mRotate = false;
+    bool mRelease = false;
+    bool mRunning = true;
+    std::mutex mMutex;
+    std::condition_variable mCv;
+
+    std::atomic<uint64_t> mDurableSequence{};
+    std::thread mWriter;
+};
+
+} // propertytree
+
+#endif // __JOURNAL_HPP__
@@ -3,15 +3,32 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <bfc/EpollReactor.hpp>
 
 #include <logless/Logger.hpp>
 
+#include <interface/protocol.hpp>
+
 namespace propertytree
 {
 
+// Aggregate: running result over the typed numeric children of the source node whose name matches pattern
+// Note: count holds the members that have a value, values is only kept for MIN and MAX.
+struct Aggregate
+{
+    AggregateFunction function;
+    uint64_t sourceUuid;
+    std::string pattern;
+    double sum = 0;
+    uint64_t count = 0;
+    std::multiset<double> values;
+};
+
 struct Node
 {
     Node() = delete;
@@ -27,9 +44,26 @@ struct Node
     std::weak_ptr<Node> parent;
     uint64_t uuid;
 
-    std::vector<uint8_t> data;
+    Buffer data;
+    uint64_t version = 0;
     std::map<std::string, std::shared_ptr<Node>> children;
     std::unordered_map<uint32_t, std::weak_ptr<IConnectionSession>> listener;
+    // treeListener: sessions that loaded the children of this node
+    std::unordered_set<uint32_t> treeListener;
+    // imageChildren: children not materialized yet from the tree image
+    bool imageChildren = false;
+    // ephemeral: removed when the creating session ends, never persisted
+    bool ephemeral = false;
+    // type: checked against every value set, NONE accepts anything
+    ValueType type = ValueType::NONE;
+    // providers: sessions registered to serve calls on this node, the creator serves them while empty
+    std::vector<uint32_t> providers;
+    // nextProvider: round-robin position among equally loaded providers
+    size_t nextProvider = 0;
+    // aggregate: set on aggregate nodes, whose value is derived and can't be set
+    std::unique_ptr<Aggregate> aggregate;
+    // aggregates: aggregate nodes fed by the children of this node
+    std::vector<std::weak_ptr<Node>> aggregates;
 
     std::mutex dataMutex;
     std::mutex childrenMutex;
@@ -0,0 +1,47 @@
+#include <Pattern.hpp>
+
+namespace propertytree
+{
+
+bool matchGlob(std::string_view pPattern, std::string_view pName)
+{
+    if (pPattern.empty())
+    {
+        return true;
+    }
+
+    size_t p = 0;
+    size_t n = 0;
+    size_t star = std::string_view::npos;
+    size_t mark = 0;
+    while (n < pName.size())
+    {
+        if (p < pPattern.size() && '*' == pPattern[p])
+        {
+            star = p++;
+            mark = n;
+        }
+        else if (p < pPattern.size() && ('?' == pPattern[p] || pPattern[p] == pName[n]))
+        {
+            p++;
+            n++;
+        }
+        else if (std::string_view::npos != star)
+        {
+            p = star + 1;
+            n = ++mark;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while (p < pPattern.size() && '*' == pPattern[p])
+    {
+        p++;
+    }
+    return pPattern.size() == p;
+}
+
+} // propertytree
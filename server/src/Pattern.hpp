@@ -0,0 +1,42 @@
+#ifndef __PATTERN_HPP__
+#define __PATTERN_HPP__
+
+#include <string_view>
+#include <vector>
+
+namespace propertytree
+{
+
+// Note: '*' matches any run of characters and '?' a single one, an empty pattern matches everything.
+bool matchGlob(std::string_view pPattern, std::string_view pName);
+
+// Note: Segments are matched one by one with matchGlob, "**" matches any number of them, none included.
+//       pSegment(i) gives the name of the i-th of the pSegmentCount segments of the path.
+template <typename T>
+bool matchPath(const std::vector<std::string_view>& pPattern, size_t pPatternIndex, T&& pSegment, size_t pSegmentIndex, size_t pSegmentCount)
+{
+    for (; pPatternIndex < pPattern.size(); pPatternIndex++, pSegmentIndex++)
+    {
+        if ("**" == pPattern[pPatternIndex])
+        {
+            for (auto i = pSegmentIndex; i <= pSegmentCount; i++)
+            {
+                if (matchPath(pPattern, pPatternIndex + 1, pSegment, i, pSegmentCount))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        if (pSegmentCount == pSegmentIndex || !matchGlob(pPattern[pPatternIndex], pSegment(pSegmentIndex)))
+        {
+            return false;
+        }
+    }
+    return pSegmentCount == pSegmentIndex;
+}
+
+} // propertytree
+
+#endif // __PATTERN_HPP__
@@ -1,4 +1,12 @@
-#include <list>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <set>
+#include <string_view>
 
 #include <bfc/ThreadPool.hpp>
 #include <bfc/Timer.hpp>
@@ -10,6 +18,7 @@
 #include <interface/protocol.hpp>
 
 #include <IConnectionSession.hpp>
+#include <Pattern.hpp>
 
 #include <ProtocolHandler.hpp>
 
@@ -17,13 +26,246 @@ namespace propertytree
 {
 
 constexpr size_t ENCODE_SIZE = 1024*64;
+// TEMPLATE_PARENT: TemplateNode::parentIndex that refers to BulkCreateRequest::parentUuid
+constexpr uint32_t TEMPLATE_PARENT = 0xFFFFFFFF;
+// Note: Queued tree updates are flushed early past this size to stay well within ENCODE_SIZE.
+constexpr size_t TREE_UPDATE_FLUSH_SIZE = 1024*32;
+// Note: BulkSubscribeResponse stops taking entries past this size, the client resends the rest.
+constexpr size_t BULK_RESPONSE_SIZE = 1024*48;
+// TREE_INFO_PAGE_SIZE: encoded size after which a TreeInfoResponse is continued in another page
+constexpr size_t TREE_INFO_PAGE_SIZE = 1024*48;
+// MAX_NODE_SIZE: name plus value size of a node, so that any node fits in a page alone
+constexpr size_t MAX_NODE_SIZE = 1024*32;
+// QUERY_PAGE_VISITS: nodes a QueryRequest page walks at most, so that sparse matches don't stall the reactor
+constexpr size_t QUERY_PAGE_VISITS = 1024*64;
+constexpr uint64_t ROOT_UUID = 0;
+
+// Note: Only async-signal-safe calls, the snapshot child of a multithreaded process runs this.
+static bool writeImage(const char* pPath, const char* pTmpPath, const std::vector<std::byte>& pImage)
+{
+    int fd = open(pTmpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (-1 == fd)
+    {
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < pImage.size())
+    {
+        auto res = ::write(fd, pImage.data() + written, pImage.size() - written);
+        if (-1 == res && EINTR == errno)
+        {
+            continue;
+        }
+        if (-1 == res)
+        {
+            close(fd);
+            return false;
+        }
+        written += res;
+    }
+
+    bool ok = !fsync(fd);
+    ok = !close(fd) && ok;
+    return ok && !rename(pTmpPath, pPath);
+}
+
+// Note: cum encodes a list length like an unsigned integer of the width reserved for it.
+static void encodeLength(std::byte* pData, size_t pSize, uint64_t pLength)
+{
+    cum::per_codec_ctx context(pData, pSize);
+    if (sizeof(uint8_t) == pSize)
+    {
+        encode_per(uint8_t(pLength), context);
+    }
+    else if (sizeof(uint16_t) == pSize)
+    {
+        encode_per(uint16_t(pLength), context);
+    }
+    else if (sizeof(uint32_t) == pSize)
+    {
+        encode_per(uint32_t(pLength), context);
+    }
+    else
+    {
+        encode_per(pLength, context);
+    }
+}
+
+// Note: Share of a queued NamedNode in pendingTreeUpdateSize, queueing and cancelling it must agree.
+static size_t pendingTreeAddSize(const NamedNode& pNode)
+{
+    return pNode.name.size() + 1 + sizeof(pNode.uuid) + sizeof(pNode.parentUuid) + sizeof(pNode.type);
+}
+
+// Note: Fixed width types must match their size exactly, STRING can't hold a NUL, NONE and BYTES take anything.
+static bool matchesType(ValueType pType, const Buffer& pData)
+{
+    switch (pType)
+    {
+        case ValueType::BOOL:
+            return 1 == pData.size() && pData[0] <= 1;
+        case ValueType::I8:
+        case ValueType::U8:
+            return sizeof(uint8_t) == pData.size();
+        case ValueType::I16:
+        case ValueType::U16:
+            return sizeof(uint16_t) == pData.size();
+        case ValueType::I32:
+        case ValueType::U32:
+        case ValueType::F32:
+            return sizeof(uint32_t) == pData.size();
+        case ValueType::I64:
+        case ValueType::U64:
+        case ValueType::F64:
+            return sizeof(uint64_t) == pData.size();
+        case ValueType::STRING:
+            return pData.end() == std::find(pData.begin(), pData.end(), 0);
+        default:
+            return true;
+    }
+}
+
+template <typename T>
+static double load(const Buffer& pData)
+{
+    T value;
+    std::memcpy(&value, pData.data(), sizeof(value));
+    return value;
+}
+
+// Note: Only typed numeric values can be aggregated, NaN would break the ordering of min and max.
+static bool toNumber(ValueType pType, const Buffer& pData, double& pValue)
+{
+    if (pData.empty() || !matchesType(pType, pData))
+    {
+        return false;
+    }
+
+    switch (pType)
+    {
+        case ValueType::BOOL:
+        case ValueType::U8:
+            pValue = load<uint8_t>(pData);
+            break;
+        case ValueType::I8:
+            pValue = load<int8_t>(pData);
+            break;
+        case ValueType::I16:
+            pValue = load<int16_t>(pData);
+            break;
+        case ValueType::U16:
+            pValue = load<uint16_t>(pData);
+            break;
+        case ValueType::I32:
+            pValue = load<int32_t>(pData);
+            break;
+        case ValueType::U32:
+            pValue = load<uint32_t>(pData);
+            break;
+        case ValueType::I64:
+            pValue = load<int64_t>(pData);
+            break;
+        case ValueType::U64:
+            pValue = load<uint64_t>(pData);
+            break;
+        case ValueType::F32:
+            pValue = load<float>(pData);
+            break;
+        case ValueType::F64:
+            pValue = load<double>(pData);
+            break;
+        default:
+            return false;
+    }
+    return !std::isnan(pValue);
+}
+
+// accumulate: replaces the contribution of pMember from its previous to its current value, empty means none
+static void accumulate(Aggregate& pAggregate, const Node& pMember, const Buffer& pPrevious, const Buffer& pCurrent)
+{
+    if (pMember.aggregate || !matchGlob(pAggregate.pattern, pMember.name))
+    {
+        return;
+    }
+
+    bool ordered = AggregateFunction::MIN == pAggregate.function || AggregateFunction::MAX == pAggregate.function;
+    double value;
+    if (toNumber(pMember.type, pPrevious, value))
+    {
+        pAggregate.sum -= value;
+        pAggregate.count--;
+        auto valueIt = ordered ? pAggregate.values.find(value) : pAggregate.values.end();
+        if (pAggregate.values.end() != valueIt)
+        {
+            pAggregate.values.erase(valueIt);
+        }
+    }
+
+    if (toNumber(pMember.type, pCurrent, value))
+    {
+        pAggregate.sum += value;
+        pAggregate.count++;
+        if (ordered)
+        {
+            pAggregate.values.emplace(value);
+        }
+    }
+
+    // Note: Start over from an exact zero once empty so that rounding errors don't build up.
+    if (!pAggregate.count)
+    {
+        pAggregate.sum = 0;
+    }
+}
+
+template <typename T>
+static Buffer store(T pValue)
+{
+    Buffer rv;
+    rv.resize(sizeof(pValue));
+    std::memcpy(rv.data(), &pValue, sizeof(pValue));
+    return rv;
+}
+
+// Note: MIN and MAX have no value while no member has one.
+static Buffer aggregateValue(const Aggregate& pAggregate)
+{
+    switch (pAggregate.function)
+    {
+        case AggregateFunction::COUNT:
+            return store(pAggregate.count);
+        case AggregateFunction::MIN:
+            return pAggregate.values.size() ? store(*pAggregate.values.begin()) : Buffer{};
+        case AggregateFunction::MAX:
+            return pAggregate.values.size() ? store(*pAggregate.values.rbegin()) : Buffer{};
+        default:
+            return store(pAggregate.sum);
+    }
+}
 
-ProtocolHandler::ProtocolHandler(bfc::LightFn<void()> pTerminator)
-    : mTerminator(pTerminator)
+ProtocolHandler::ProtocolHandler(bfc::LightFn<void()> pTerminator, const ServerConfig& pConfig)
+    : mSnapshotTime(std::chrono::steady_clock::now())
+    , mTerminator(pTerminator)
+    , mConfig(pConfig)
 {
     auto rootUUid = mUuidCtr++;
 
-    mTree.emplace(rootUUid, std::make_shared<Node>("", 0xFFFFFFFF, std::weak_ptr<Node>(), rootUUid));
+    mTree.emplace(rootUUid, std::make_shared<Node>("", NO_SESSION, std::weak_ptr<Node>(), rootUUid));
+
+    if (mConfig.snapshotPath.size())
+    {
+        loadSnapshot(mConfig.snapshotPath);
+    }
+
+    if (mConfig.journalPath.size())
+    {
+        replayJournal(mConfig.journalPath);
+        mJournal = std::make_unique<Journal>(mConfig.journalPath, mConfig.journalSyncPeriod, mConfig.journalSyncSize);
+    }
+
+    mChangeLog.clear();
+    mChangeLogFloor = mSequence;
 }
 
 void ProtocolHandler::onDisconnect(IConnectionSession* pConnection)
@@ -36,8 +278,49 @@ void ProtocolHandler::onDisconnect(IConnectionSession* pConnection)
     }
     auto sessionId = sessionIdIt->second;
     mConnectionToSessionId.erase(sessionIdIt);
-    auto sessionIt = mSessions.find(sessionId);
-    sessionIt->second->connectionSession.reset();
+    auto& session = *mSessions.at(sessionId);
+    session.connectionSession.reset();
+    disarmLiveness(session);
+
+    // Note: Callers learn right away that the provider is gone instead of waiting for the deadline.
+    while (session.incomingCalls.size())
+    {
+        auto callId = *session.incomingCalls.begin();
+        auto callIt = mPendingCalls.find(callId);
+        if (mPendingCalls.end() == callIt)
+        {
+            Logless("ERR ProtocolHandler: session _ serves unknown call _.", sessionId, callId);
+            session.incomingCalls.erase(callId);
+            continue;
+        }
+        failCall(callIt, Cause::NO_HANDLER);
+    }
+
+    // Note: The session is kept for the grace period so that the client can resume it.
+    session.disconnectTime = std::chrono::steady_clock::now();
+    mDisconnectedSessions.emplace_back(session.disconnectTime, sessionId);
+}
+
+void ProtocolHandler::onTick()
+{
+    auto pending = std::move(mTreeUpdatePending);
+    mTreeUpdatePending.clear();
+    for (auto i : pending)
+    {
+        flushTreeUpdate(i);
+    }
+
+    checkSnapshot();
+    sendDurableAcks();
+    expireSessions();
+
+    mLivenessWheel.advance([this](uint64_t pSessionId){
+            checkLiveness(pSessionId);
+        });
+
+    mRpcWheel.advance([this](uint64_t pCallId){
+            expireCall(pCallId);
+        });
 }
 
 void ProtocolHandler::onMsg(bfc::ConstBufferView pMsg, std::shared_ptr<IConnectionSession> pConnection)
@@ -51,6 +334,14 @@ void ProtocolHandler::onMsg(bfc::ConstBufferView pMsg, std::shared_ptr<IConnecti
     str("root", message, stred, true);
     Logless("DBG ProtocolHandler: receive: session=_ decoded=_", pConnection.get(),  stred.c_str());
 
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() != sessionIdIt)
+    {
+        auto& session = *mSessions.at(sessionIdIt->second);
+        session.lastActivity = mLivenessWheel.now();
+        session.probed = false;
+    }
+
     std::visit([this, &pConnection](auto&& pMsg) {
             onMsg(std::move(pMsg), pConnection);
         }, std::move(message));
@@ -78,12 +369,91 @@ void ProtocolHandler::handle(uint16_t pTransactionId, SigninRequest&& pMsg, std:
     auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
     propertyTreeMessage.transactionId = pTransactionId;
     propertyTreeMessage.message = SigninAccept{};
+    auto& signinAccept = std::get<SigninAccept>(propertyTreeMessage.message);
 
     auto sessionId = mSessionIdCtr++;
-    mSessions.emplace(sessionId, std::make_shared<Session>(pConnection));
+    auto session = std::make_shared<Session>(pConnection);
+
+    do
+    {
+        session->token = mTokenGenerator();
+    } while (!session->token || !mSessionTokens.emplace(session->token, sessionId).second);
+
+    mSessions.emplace(sessionId, session);
+    mConnectionToSessionId.emplace(pConnection.get(), sessionId);
+    armLiveness(*session, sessionId);
+
+    signinAccept.sessionId = sessionId;
+    signinAccept.token = session->token;
+    signinAccept.sequence = mSequence;
+    send(message, pConnection);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, ResumeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = ResumeReject{};
+    auto& resumeReject = std::get<ResumeReject>(propertyTreeMessage.message);
+    resumeReject.cause = Cause::NOT_FOUND;
+
+    auto tokenIt = mSessionTokens.find(pMsg.token);
+    if (mSessionTokens.end() == tokenIt)
+    {
+        send(message, pConnection);
+        return;
+    }
+
+    if (mConnectionToSessionId.count(pConnection.get()))
+    {
+        resumeReject.cause = Cause::NOT_PERMITTED;
+        send(message, pConnection);
+        return;
+    }
+
+    // Note: Changes older than the change log are gone, the client has to start over.
+    if (pMsg.sequence < mChangeLogFloor || pMsg.sequence > mSequence)
+    {
+        resumeReject.cause = Cause::EXPIRED;
+        send(message, pConnection);
+        return;
+    }
+
+    auto sessionId = tokenIt->second;
+    auto& session = *mSessions.at(sessionId);
+
+    if (session.connectionSession)
+    {
+        mConnectionToSessionId.erase(session.connectionSession.get());
+    }
+    session.connectionSession = pConnection;
     mConnectionToSessionId.emplace(pConnection.get(), sessionId);
 
+    for (auto uuid : session.subscriptions)
+    {
+        auto nodeIt = mTree.find(uuid);
+        if (mTree.end() != nodeIt)
+        {
+            nodeIt->second->listener[sessionId] = pConnection;
+        }
+    }
+
+    // Note: Whatever was still queued for the old connection is covered by the replayed changes.
+    session.pendingTreeAdd.clear();
+    session.pendingTreeDelete.clear();
+    session.pendingTreeUpdateSize = 0;
+
+    armLiveness(session, sessionId);
+    resync(sessionId, pMsg.sequence);
+
+    propertyTreeMessage.message = ResumeAccept{};
+    auto& resumeAccept = std::get<ResumeAccept>(propertyTreeMessage.message);
+    resumeAccept.sequence = mSequence;
     send(message, pConnection);
+
+    Logless("INF ProtocolHandler: session _ resumed sequence=_..._", sessionId, pMsg.sequence, mSequence);
 }
 
 void ProtocolHandler::handle(uint16_t pTransactionId, CreateRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
@@ -96,14 +466,13 @@ void ProtocolHandler::handle(uint16_t pTransactionId, CreateRequest&& pMsg, std:
     auto& createReject = std::get<CreateReject>(propertyTreeMessage.message);
     createReject.cause = Cause::NOT_FOUND;
 
-    auto foundIt = mTree.find(pMsg.parentUuid);
+    auto node = findNode(pMsg.parentUuid);
 
-    if (mTree.end() == foundIt)
+    if (!node)
     {
         send(message, pConnection);
         return;
     }
-    auto node = foundIt->second;
 
     auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
     if (mConnectionToSessionId.end() == sessionIdIt)
@@ -113,6 +482,22 @@ void ProtocolHandler::handle(uint16_t pTransactionId, CreateRequest&& pMsg, std:
     }
     auto sessionId = sessionIdIt->second;
 
+    // Note: Ephemeral nodes have no children, so removing them never takes persistent nodes along.
+    if (node->ephemeral)
+    {
+        createReject.cause = Cause::NOT_PERMITTED;
+        send(message, pConnection);
+        return;
+    }
+
+    if (pMsg.name.size() > MAX_NODE_SIZE)
+    {
+        createReject.cause = Cause::TOO_LARGE;
+        send(message, pConnection);
+        return;
+    }
+
+    loadChildren(*node);
     auto res = node->children.emplace(pMsg.name, std::make_shared<Node>(pMsg.name, sessionId, node, -1));
     auto insertedNode = res.first->second;
 
@@ -125,426 +510,2336 @@ void ProtocolHandler::handle(uint16_t pTransactionId, CreateRequest&& pMsg, std:
 
     auto uuid = mUuidCtr++;
     insertedNode->uuid = uuid;
+    insertedNode->type = pMsg.type;
 
     mTree.emplace(uuid, insertedNode);
+    mSequence++;
+    logChange(ChangeLogEntry::ADD, uuid, node->uuid);
 
     propertyTreeMessage.message = CreateAccept{};
     auto& createAccept = std::get<CreateAccept>(propertyTreeMessage.message);
     createAccept.uuid = uuid;
-    send(message, pConnection);
 
+    // Note: Ephemeral nodes are neither journaled nor snapshotted, they don't outlive the server.
+    if (pMsg.ephemeral)
     {
-        PropertyTreeProtocol message = PropertyTreeMessage{};
-        auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-        propertyTreeMessage.transactionId = 0xFFFF;
-        propertyTreeMessage.message = TreeUpdateNotification{};
-        auto& treeUpdateNotification = std::get<TreeUpdateNotification>(propertyTreeMessage.message);
-
-        treeUpdateNotification.nodeToAddList.emplace_back(NamedNode{pMsg.name, insertedNode->uuid, node->uuid});
-
-        std::byte buffer[ENCODE_SIZE];
-        auto msgSize = encode(message, buffer, sizeof(buffer));
-
-        for (auto& i : mSessions)
-        {
-            send(buffer, msgSize, i.second->connectionSession);
-        }
+        insertedNode->ephemeral = true;
+        mSessions.at(sessionId)->ephemerals.emplace(uuid);
+        send(message, pConnection);
     }
-}
-
-template <typename T>
-void ProtocolHandler::fillToAddListFromTree(T& pIe, std::shared_ptr<Node>& pNode, bool pRecursive)
-{
-    LOGLESS_TRACE();
-    struct TraversalContext
-    {
-        TraversalContext(std::shared_ptr<Node> pNode, std::map<std::string, std::shared_ptr<Node>>::iterator pIt)
-            : parentNode(pNode)
-            , current(pIt)
-        {}
-
-        std::shared_ptr<Node> parentNode;
-        std::map<std::string, std::shared_ptr<Node>>::iterator current;
-    };
-
-    auto currentNode = pNode;
-    std::list<TraversalContext> levels;
-
-    levels.emplace_back(TraversalContext(currentNode, currentNode->children.begin()));
-
-    while (true)
+    else
     {
-        auto& currentLevel = levels.back();
+        journal(Journal::RecordType::CREATE, uuid, node->uuid, pMsg.name.data(), pMsg.name.size(), pMsg.type);
+        sendDurable(message, pConnection);
+    }
 
-        if (currentLevel.parentNode->children.end() == currentLevel.current)
-        {
-            levels.pop_back();
-            if (!levels.size())
-            {
-                break;
-            }
-            continue;
-        }
+    addTreeListener(*node, sessionId);
+    addTreeListener(*insertedNode, sessionId);
 
-        pIe.nodeToAddList.emplace_back(NamedNode{currentLevel.current->first, currentLevel.current->second->uuid, currentLevel.parentNode->uuid});
-        if (currentLevel.current->second->children.size() && pRecursive)
-        {
-            levels.emplace_back(TraversalContext(currentLevel.current->second, currentLevel.current->second->children.begin()));
-            currentLevel.current++;
-            continue;
-        }
-        currentLevel.current++;
-    }
+    // Note: The creator already knows the node from CreateAccept.
+    queueTreeAdd(node->treeListener, NamedNode{pMsg.name, insertedNode->uuid, node->uuid, pMsg.type}, sessionId);
 }
 
-void ProtocolHandler::handle(uint16_t pTransactionId, TreeInfoRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+void ProtocolHandler::handle(uint16_t pTransactionId, BulkCreateRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
 {
     LOGLESS_TRACE();
     PropertyTreeProtocol message = PropertyTreeMessage{};
     auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
     propertyTreeMessage.transactionId = pTransactionId;
-    propertyTreeMessage.message = TreeInfoErrorResponse{};
-    auto& treeInfoErrorResponse = std::get<TreeInfoErrorResponse>(propertyTreeMessage.message);
-    treeInfoErrorResponse.cause = Cause::NOT_FOUND;
+    propertyTreeMessage.message = BulkCreateReject{};
+    auto& bulkCreateReject = std::get<BulkCreateReject>(propertyTreeMessage.message);
+    bulkCreateReject.cause = Cause::NOT_FOUND;
 
-    auto foundItParent = mTree.find(pMsg.parentUuid);
-    if (mTree.end() == foundItParent)
+    auto node = findNode(pMsg.parentUuid);
+    if (!node)
     {
         send(message, pConnection);
         return;
     }
-    auto parentNode = foundItParent->second;
 
-    std::shared_ptr<propertytree::Node> node;
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt)
+    {
+        Logless("ERR ProtocolHandler: BulkCreateRequest from a non signedin connection.");
+        return;
+    }
+    auto sessionId = sessionIdIt->second;
 
-    if ("." == pMsg.name)
+    if (node->ephemeral)
     {
-        node = parentNode;
+        bulkCreateReject.cause = Cause::NOT_PERMITTED;
+        send(message, pConnection);
+        return;
     }
-    else
+
+    loadChildren(*node);
+
+    // Note: Validate the whole template first so that it is inserted all or nothing.
+    std::set<std::pair<uint32_t, std::string_view>> names;
+    for (auto i = 0u; i < pMsg.nodes.size(); i++)
     {
-        auto foundIt = parentNode->children.find(pMsg.name);
-        if (parentNode->children.end() == foundIt)
+        auto& templateNode = pMsg.nodes[i];
+        if (TEMPLATE_PARENT != templateNode.parentIndex && templateNode.parentIndex >= i)
         {
+            bulkCreateReject.cause = Cause::NOT_PERMITTED;
             send(message, pConnection);
             return;
         }
-        node = foundIt->second;
-    }
-
-    propertyTreeMessage.message = TreeInfoResponse{};
-    auto& treeInfoResponse = std::get<TreeInfoResponse>(propertyTreeMessage.message);
 
-    if ("." != pMsg.name)
-    {
-        treeInfoResponse.nodeToAddList.emplace_back(NamedNode{pMsg.name, node->uuid, parentNode->uuid});
-    }
+        if ((TEMPLATE_PARENT == templateNode.parentIndex && node->children.count(templateNode.name)) ||
+            !names.emplace(templateNode.parentIndex, templateNode.name).second)
+        {
+            bulkCreateReject.cause = Cause::ALREADY_EXIST;
+            send(message, pConnection);
+            return;
+        }
 
-    fillToAddListFromTree(treeInfoResponse, node, pMsg.recursive);
-    send(message, pConnection);
-}
+        if (templateNode.data.size() && !matchesType(templateNode.type, templateNode.data))
+        {
+            bulkCreateReject.cause = Cause::TYPE_MISMATCH;
+            send(message, pConnection);
+            return;
+        }
 
-void ProtocolHandler::handle(uint16_t pTransactionId, SetValueRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
-{
-    LOGLESS_TRACE();
-    if (0 == pMsg.uuid && 4 == pMsg.data.size())
-    {
-        uint32_t value;
-        std::memcpy(&value, pMsg.data.data(), 4);
-        if (9u == value)
+        if (templateNode.name.size() + templateNode.data.size() > MAX_NODE_SIZE)
         {
-            Logless("INF ProtocolHandler: terminate signal received!");
-            mTerminator();
+            bulkCreateReject.cause = Cause::TOO_LARGE;
+            send(message, pConnection);
             return;
         }
     }
 
-    auto foundIt = mTree.find(pMsg.uuid);
-
-    if (mTree.end() == foundIt)
-    {
-        return;
-    }
-    auto node = foundIt->second;
+    std::vector<std::shared_ptr<Node>> inserted;
+    inserted.reserve(pMsg.nodes.size());
 
-    node->data = std::move(pMsg.data);
+    propertyTreeMessage.message = BulkCreateAccept{};
+    auto& bulkCreateAccept = std::get<BulkCreateAccept>(propertyTreeMessage.message);
+    bulkCreateAccept.uuids.reserve(pMsg.nodes.size());
 
-    PropertyTreeProtocol message = PropertyTreeMessage{};
-    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-    propertyTreeMessage.transactionId = pTransactionId;
-    propertyTreeMessage.message = SetValueAccept{};
-    send(message, pConnection);
+    addTreeListener(*node, sessionId);
+    mSequence++;
 
-    propertyTreeMessage.transactionId = 0xFFFF;
-    propertyTreeMessage.message = UpdateNotification{};
-    auto& updateNotification = std::get<UpdateNotification>(propertyTreeMessage.message);
-    updateNotification.uuid = node->uuid;
+    for (auto& i : pMsg.nodes)
+    {
+        auto& parentNode = TEMPLATE_PARENT == i.parentIndex ? node : inserted[i.parentIndex];
+        auto uuid = mUuidCtr++;
 
-    updateNotification.data = node->data;
+        auto insertedNode = std::make_shared<Node>(i.name, sessionId, parentNode, uuid);
+        insertedNode->type = i.type;
+        if (i.data.size())
+        {
+            insertedNode->data = std::move(i.data);
+            insertedNode->version = 1;
+        }
+        addTreeListener(*insertedNode, sessionId);
 
-    std::byte buffer[ENCODE_SIZE];
-    auto msgSize = encode(message, buffer, sizeof(buffer));
+        parentNode->children.emplace(i.name, insertedNode);
+        mTree.emplace(uuid, insertedNode);
+        inserted.emplace_back(insertedNode);
 
-    for (auto i = node->listener.begin(); node->listener.end() != i; i++)
-    {
-        auto connection = i->second.lock();
-        if (!connection)
+        journal(Journal::RecordType::CREATE, uuid, parentNode->uuid, i.name.data(), i.name.size(), i.type);
+        logChange(ChangeLogEntry::ADD, uuid, parentNode->uuid);
+        if (insertedNode->version)
         {
-            auto sessionIt = mSessions.find(i->first);
-            if (mSessions.end() == sessionIt)
-            {
-                continue;
-            }
-            connection = sessionIt->second->connectionSession;
-            if (!connection)
-            {
-                continue;
-            }
-            i->second = connection;
+            journal(Journal::RecordType::SET, uuid, insertedNode->version, insertedNode->data.data(), insertedNode->data.size());
         }
+        bulkCreateAccept.uuids.emplace_back(uuid);
 
-        send(buffer, msgSize, connection);
+        // Note: Only the creator has loaded the new nodes, others only learn about the top level ones.
+        queueTreeAdd(parentNode->treeListener, NamedNode{i.name, uuid, parentNode->uuid, i.type}, sessionId);
     }
-}
 
-void ProtocolHandler::handle(uint16_t pTransactionId, GetRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
-{
-    LOGLESS_TRACE();
-    PropertyTreeProtocol message = PropertyTreeMessage{};
-    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-    propertyTreeMessage.transactionId = pTransactionId;
-    propertyTreeMessage.message = GetReject{};
-    auto& getReject = std::get<GetReject>(propertyTreeMessage.message);
-    getReject.cause = Cause::NOT_FOUND;
+    sendDurable(message, pConnection);
 
-    auto foundIt = mTree.find(pMsg.uuid);
-    if (mTree.end() == foundIt)
+    // Note: Only the top level nodes can be members, the others have new parents.
+    if (node->aggregates.size())
     {
-        send(message, pConnection);
-        return;
+        updateAggregates(*node, [&](Aggregate& pAggregate) {
+                for (auto i = 0u; i < inserted.size(); i++)
+                {
+                    if (TEMPLATE_PARENT == pMsg.nodes[i].parentIndex)
+                    {
+                        accumulate(pAggregate, *inserted[i], Buffer{}, inserted[i]->data);
+                    }
+                }
+            });
     }
-    auto node = foundIt->second;
-
-    propertyTreeMessage.message = GetAccept{};
-    auto& getAccept = std::get<GetAccept>(propertyTreeMessage.message);
-    getAccept.data = node->data;
-
-    send(message, pConnection);
 }
 
-void ProtocolHandler::handle(uint16_t pTransactionId, SubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+void ProtocolHandler::handle(uint16_t pTransactionId, AggregateCreateRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
 {
     LOGLESS_TRACE();
     PropertyTreeProtocol message = PropertyTreeMessage{};
     auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
     propertyTreeMessage.transactionId = pTransactionId;
-    propertyTreeMessage.message = SubscribeResponse{};
-    auto& subscribeResponse = std::get<SubscribeResponse>(propertyTreeMessage.message);
-    subscribeResponse.cause = Cause::NOT_FOUND;
+    propertyTreeMessage.message = CreateReject{};
+    auto& createReject = std::get<CreateReject>(propertyTreeMessage.message);
+    createReject.cause = Cause::NOT_FOUND;
 
-    auto foundIt = mTree.find(pMsg.uuid);
-    if (mTree.end() == foundIt)
+    auto node = findNode(pMsg.parentUuid);
+    auto source = findNode(pMsg.sourceUuid);
+    if (!node || !source)
     {
         send(message, pConnection);
         return;
     }
-    auto node = foundIt->second;
 
     auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
     if (mConnectionToSessionId.end() == sessionIdIt)
     {
-        Logless("ERR ProtocolHandler: SubscribeRequest from a non signedin connection.");
+        Logless("ERR ProtocolHandler: AggregateCreateRequest from a non signedin connection.");
         return;
     }
     auto sessionId = sessionIdIt->second;
 
-    node->listener[sessionId] = pConnection;
-
-    subscribeResponse.cause = Cause::OK;
-    send(message, pConnection);
-}
-
-void ProtocolHandler::handle(uint16_t pTransactionId, UnsubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
-{
-    LOGLESS_TRACE();
-    PropertyTreeProtocol message = PropertyTreeMessage{};
-    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-    propertyTreeMessage.transactionId = pTransactionId;
-    propertyTreeMessage.message = UnsubscribeResponse{};
-    auto& unsubscribeResponse = std::get<UnsubscribeResponse>(propertyTreeMessage.message);
-    unsubscribeResponse.cause = Cause::NOT_FOUND;
-
-    auto foundIt = mTree.find(pMsg.uuid);
-    if (mTree.end() == foundIt)
+    if (node->ephemeral)
     {
+        createReject.cause = Cause::NOT_PERMITTED;
         send(message, pConnection);
         return;
     }
-    auto node = foundIt->second;
 
-    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
-    if (mConnectionToSessionId.end() == sessionIdIt)
+    if (pMsg.name.size() + sizeof(uint64_t) > MAX_NODE_SIZE)
     {
+        createReject.cause = Cause::TOO_LARGE;
+        send(message, pConnection);
         return;
     }
-    auto sessionId = sessionIdIt->second;
 
-    auto listenerIt = node->listener.find(sessionId);
-    if (node->listener.end() == listenerIt)
+    loadChildren(*node);
+    auto res = node->children.emplace(pMsg.name, std::make_shared<Node>(pMsg.name, sessionId, node, -1));
+    auto insertedNode = res.first->second;
+
+    if (false == res.second)
     {
+        createReject.cause = Cause::ALREADY_EXIST;
         send(message, pConnection);
         return;
     }
-    node->listener.erase(listenerIt);
 
-    unsubscribeResponse.cause = Cause::OK;
+    auto uuid = mUuidCtr++;
+    insertedNode->uuid = uuid;
+    insertedNode->type = AggregateFunction::COUNT == pMsg.function ? ValueType::U64 : ValueType::F64;
+    // Note: Aggregates are derived state, they live as ephemeral nodes of the session that defined them.
+    insertedNode->ephemeral = true;
+    insertedNode->aggregate = std::make_unique<Aggregate>(Aggregate{pMsg.function, source->uuid, pMsg.pattern});
+
+    mTree.emplace(uuid, insertedNode);
+    mSequence++;
+    logChange(ChangeLogEntry::ADD, uuid, node->uuid);
+    mSessions.at(sessionId)->ephemerals.emplace(uuid);
+
+    // Note: The only full scan of the members, later changes are applied one by one.
+    loadChildren(*source);
+    for (auto& child : source->children)
+    {
+        accumulate(*insertedNode->aggregate, *child.second, Buffer{}, child.second->data);
+    }
+    source->aggregates.emplace_back(insertedNode);
+    insertedNode->data = aggregateValue(*insertedNode->aggregate);
+    insertedNode->version = insertedNode->data.size() ? 1 : 0;
+
+    propertyTreeMessage.message = CreateAccept{};
+    auto& createAccept = std::get<CreateAccept>(propertyTreeMessage.message);
+    createAccept.uuid = uuid;
     send(message, pConnection);
+
+    addTreeListener(*node, sessionId);
+    addTreeListener(*insertedNode, sessionId);
+
+    queueTreeAdd(node->treeListener, NamedNode{pMsg.name, uuid, node->uuid, insertedNode->type}, sessionId);
+
+    Logless("INF ProtocolHandler: aggregate _ over _ pattern=\"_\" members=_", uuid, source->uuid, pMsg.pattern, insertedNode->aggregate->count);
 }
 
-void ProtocolHandler::handle(uint16_t pTransactionId, DeleteRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+template <typename T>
+uint64_t ProtocolHandler::traverseTree(Node& pNode, bool pRecursive, Node* pFrom, T&& pVisitor, size_t pMaxDepth)
 {
     LOGLESS_TRACE();
+    auto& levels = mTraversalStack;
+    levels.clear();
 
-    PropertyTreeProtocol message = PropertyTreeMessage{};
-    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-    propertyTreeMessage.transactionId = pTransactionId;
-    propertyTreeMessage.message = DeleteResponse{};
-    auto& deleteResponse = std::get<DeleteResponse>(propertyTreeMessage.message);
-    deleteResponse.cause = Cause::NOT_FOUND;
-
-    auto foundIt = mTree.find(pMsg.uuid);
-    if (mTree.end() == foundIt)
+    if (pFrom)
     {
-        send(message, pConnection);
-        return;
+        // Note: Resume by rebuilding the traversal stack from the ancestry of the next node. The
+        //       ancestors were already visited, their levels continue with their next sibling.
+        for (auto node = pFrom; node != &pNode;)
+        {
+            auto parentNode = node->parent.lock().get();
+            auto current = parentNode->children.find(node->name);
+            if (node != pFrom)
+            {
+                current++;
+            }
+            levels.emplace_back(parentNode, current);
+            node = parentNode;
+        }
+        std::reverse(levels.begin(), levels.end());
     }
-    auto node = foundIt->second;
-
-    if (node->children.size())
+    else
     {
-        deleteResponse.cause = Cause::NOT_EMPTY;
-        send(message, pConnection);
-        return;
+        loadChildren(pNode);
+        levels.emplace_back(&pNode, pNode.children.begin());
     }
-    auto name = node->name;
 
-    auto parentNode = node->parent.lock();
-    mTree.erase(pMsg.uuid);
+    while (levels.size())
+    {
+        auto& [parentNode, current] = levels.back();
 
-    parentNode->children.erase(name);
+        if (parentNode->children.end() == current)
+        {
+            levels.pop_back();
+            continue;
+        }
 
-    deleteResponse.cause = Cause::OK;
-    send(message, pConnection);
+        auto& node = *current->second;
+        if (!pVisitor(*parentNode, node))
+        {
+            return node.uuid;
+        }
+        current++;
+
+        if (pRecursive && levels.size() < pMaxDepth && (node.imageChildren || node.children.size()))
+        {
+            loadChildren(node);
+            levels.emplace_back(&node, node.children.begin());
+        }
+    }
+    return 0;
+}
 
+size_t ProtocolHandler::encodeTreeInfoResponse(uint16_t pTransactionId, Node* pNamedParent, Node& pNode, bool pRecursive, bool pWithValue,
+    uint32_t pSessionId, Node* pFrom, std::byte* pData, size_t pSize)
+{
+    LOGLESS_TRACE();
+    auto& msgSize = *(new (pData) uint16_t(0));
+    auto payload = pData + sizeof(msgSize);
+    auto payloadSize = pSize - sizeof(msgSize);
+    cum::per_codec_ctx context(payload, payloadSize);
+    auto position = [&context, payloadSize]() {
+            return payloadSize - context.size();
+        };
+
+    encode_per(uint8_t(cum::GetIndexByType<PropertyTreeProtocol, PropertyTreeMessage>()), context);
+    encode_per(pTransactionId, context);
+    encode_per(uint8_t(cum::GetIndexByType<PropertyTreeMessages, TreeInfoResponse>()), context);
+
+    // Note: The node count is only known after the page is full, an empty list is encoded in
+    //       its place and its length prefix is overwritten at the end.
+    auto nodeCountPosition = position();
+    encode_per(NamedNodeList{}, context);
+    auto lengthSize = position() - nodeCountPosition;
+
+    uint64_t nodeCount = 0;
+    size_t valueSize = 0;
+    Session* session = pRecursive && NO_SESSION != pSessionId ? mSessions.at(pSessionId).get() : nullptr;
+
+    // Note: Upper bounds of what a node adds to the NamedNodeList and to the NodeValueList.
+    auto namedNodeSize = [lengthSize](Node& pNode) {
+            return pNode.name.size() + lengthSize + 2*sizeof(uint64_t) + sizeof(pNode.type);
+        };
+    auto nodeValueSize = [lengthSize, pWithValue](Node& pNode) {
+            return pWithValue ? pNode.data.size() + sizeof(uint64_t) + lengthSize : 0;
+        };
+
+    if (pNamedParent)
     {
-        PropertyTreeProtocol message = PropertyTreeMessage{};
-        auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-        propertyTreeMessage.transactionId = 0xFFFF;
-        propertyTreeMessage.message = TreeUpdateNotification{};
-        auto& treeUpdateNotification = std::get<TreeUpdateNotification>(propertyTreeMessage.message);
+        encode_per(pNode.name, context);
+        encode_per(pNode.uuid, context);
+        encode_per(pNamedParent->uuid, context);
+        encode_per(pNode.type, context);
+        valueSize += nodeValueSize(pNode);
+        nodeCount++;
+    }
+
+    auto continuation = traverseTree(pNode, pRecursive, pFrom, [&](Node& pParent, Node& pChild) {
+            // Note: The first node of a page is always taken so that a continuation always makes progress.
+            if (nodeCount && position() + valueSize + namedNodeSize(pChild) + nodeValueSize(pChild) >= TREE_INFO_PAGE_SIZE)
+            {
+                return false;
+            }
+            encode_per(pChild.name, context);
+            encode_per(pChild.uuid, context);
+            encode_per(pParent.uuid, context);
+            encode_per(pChild.type, context);
+            valueSize += nodeValueSize(pChild);
+            if (session && pChild.treeListener.emplace(pSessionId).second)
+            {
+                session->interests.emplace(pChild.uuid);
+            }
+            nodeCount++;
+            return true;
+        });
 
-        treeUpdateNotification.nodeToDelete.emplace_back(pMsg.uuid);
+    encodeLength(payload + nodeCountPosition, lengthSize, nodeCount);
+    encode_per(continuation, context);
 
-        std::byte buffer[ENCODE_SIZE];
-        auto msgSize = encode(message, buffer, sizeof(buffer));
+    auto valueCountPosition = position();
+    encode_per(NodeValueList{}, context);
 
-        for (auto& i : mSessions)
+    if (pWithValue)
+    {
+        encodeLength(payload + valueCountPosition, lengthSize, nodeCount);
+
+        // Note: Second pass over the same nodes, nothing can change the tree in between.
+        auto remaining = nodeCount;
+        if (pNamedParent)
         {
-            send(buffer, msgSize, i.second->connectionSession);
+            encode_per(pNode.version, context);
+            encode_per(pNode.data, context);
+            remaining--;
         }
+
+        traverseTree(pNode, pRecursive, pFrom, [&](Node&, Node& pChild) {
+                if (!remaining)
+                {
+                    return false;
+                }
+                encode_per(pChild.version, context);
+                encode_per(pChild.data, context);
+                remaining--;
+                return true;
+            });
     }
+
+    msgSize = position();
+    Logless("DBG ProtocolHandler: send: TreeInfoResponse nodes=_ continuation=_", nodeCount, continuation);
+    return msgSize + sizeof(msgSize);
 }
 
-void ProtocolHandler::handle(uint16_t pTransactionId, RpcRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+void ProtocolHandler::handle(uint16_t pTransactionId, TreeInfoRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
 {
     LOGLESS_TRACE();
     PropertyTreeProtocol message = PropertyTreeMessage{};
     auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-    propertyTreeMessage.message = std::move(pMsg);
-
-    PropertyTreeProtocol messageReject = PropertyTreeMessage{};
-    auto& propertyTreeMessageReject = std::get<PropertyTreeMessage>(messageReject);
-    propertyTreeMessageReject.message = RpcReject{};
-    propertyTreeMessageReject.transactionId = pTransactionId;
-    auto& rpcReject = std::get<RpcReject>(propertyTreeMessageReject.message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = TreeInfoErrorResponse{};
+    auto& treeInfoErrorResponse = std::get<TreeInfoErrorResponse>(propertyTreeMessage.message);
+    treeInfoErrorResponse.cause = Cause::NOT_FOUND;
 
-    auto foundIt = mTree.find(pMsg.uuid);
-    if (mTree.end() == foundIt)
+    auto parentNode = findNode(pMsg.parentUuid);
+    if (!parentNode)
     {
-        rpcReject.cause = Cause::NOT_FOUND;
-        send(messageReject, pConnection);
+        send(message, pConnection);
         return;
     }
-    auto node = foundIt->second;
 
-    auto sourceSessionIt = mConnectionToSessionId.find(pConnection.get());
-    if (mConnectionToSessionId.end() == sourceSessionIt)
+    std::shared_ptr<propertytree::Node> node;
+
+    if ("." == pMsg.name)
     {
-        return;
+        node = parentNode;
+    }
+    else
+    {
+        loadChildren(*parentNode);
+        auto foundIt = parentNode->children.find(pMsg.name);
+        if (parentNode->children.end() == foundIt)
+        {
+            send(message, pConnection);
+            return;
+        }
+        node = foundIt->second;
     }
-    auto sourceSessionId = sourceSessionIt->second;
-    auto sessionId = node->sessionId;
-    auto targetConnection =  mSessions.find(sessionId)->second->connectionSession;
 
-    if (!targetConnection)
+    std::shared_ptr<Node> from;
+    if (pMsg.continuation)
     {
-        return;
+        from = findNode(pMsg.continuation);
+        if (!from)
+        {
+            send(message, pConnection);
+            return;
+        }
+
+        auto ancestor = from->parent.lock();
+        while (pMsg.recursive && ancestor && ancestor != node)
+        {
+            ancestor = ancestor->parent.lock();
+        }
+        if (ancestor != node)
+        {
+            treeInfoErrorResponse.cause = Cause::NOT_PERMITTED;
+            send(message, pConnection);
+            return;
+        }
+    }
+
+    auto sessionId = NO_SESSION;
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() != sessionIdIt)
+    {
+        sessionId = sessionIdIt->second;
     }
 
-    auto trId = mTrIdCtr++;
-    propertyTreeMessage.transactionId = trId;
+    Node* namedParent = nullptr;
+    if ("." != pMsg.name && !from)
+    {
+        namedParent = parentNode.get();
+        if (NO_SESSION != sessionId)
+        {
+            addTreeListener(*parentNode, sessionId);
+        }
+    }
 
-    mTrIdTranslation[trId] = std::pair<uint32_t, uint16_t>(sourceSessionId, pTransactionId);
+    if (NO_SESSION != sessionId)
+    {
+        addTreeListener(*node, sessionId);
 
-    send(message, targetConnection);
+        // Note: Deliver the queued tree updates first so that later ones can't be cancelled against
+        //       a node the session only learned from this response.
+        flushTreeUpdate(sessionId);
+    }
+
+    std::byte buffer[ENCODE_SIZE];
+    auto msgSize = encodeTreeInfoResponse(pTransactionId, namedParent, *node, pMsg.recursive, pMsg.withValue, sessionId, from.get(), buffer, sizeof(buffer));
+    send(buffer, msgSize, pConnection);
 }
 
-template<typename T>
-void ProtocolHandler::handleRpc(uint16_t pTransactionId, T&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+void ProtocolHandler::handle(uint16_t pTransactionId, QueryRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
 {
     LOGLESS_TRACE();
-    auto translationIt = mTrIdTranslation.find(pTransactionId);
-    if (mTrIdTranslation.end() == translationIt)
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = QueryReject{};
+    auto& queryReject = std::get<QueryReject>(propertyTreeMessage.message);
+    queryReject.cause = Cause::NOT_FOUND;
+
+    auto node = findNode(pMsg.rootUuid);
+    if (!node)
     {
+        send(message, pConnection);
         return;
     }
-    auto translation = translationIt->second;
-    mTrIdTranslation.erase(translationIt);
 
-    PropertyTreeProtocol message = PropertyTreeMessage{};
-    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-    propertyTreeMessage.message = std::move(pMsg);
-    propertyTreeMessage.transactionId = translation.second;
+    std::shared_ptr<Node> from;
+    if (pMsg.continuation)
+    {
+        from = findNode(pMsg.continuation);
+        if (!from)
+        {
+            send(message, pConnection);
+            return;
+        }
 
-    auto targetSessionIt =  mSessions.find(translation.first);
-    if (mSessions.end() == targetSessionIt)
+        auto ancestor = from->parent.lock();
+        while (ancestor && ancestor != node)
+        {
+            ancestor = ancestor->parent.lock();
+        }
+        if (ancestor != node)
+        {
+            queryReject.cause = Cause::NOT_PERMITTED;
+            send(message, pConnection);
+            return;
+        }
+    }
+
+    // Note: Without "**" nothing deeper than the pattern can match, the walk stops there.
+    std::vector<std::string_view> pattern;
+    bool unbounded = false;
+    std::string_view remaining = pMsg.pattern;
+    while (remaining.size())
     {
-        return;
+        auto end = remaining.find('/');
+        auto segment = remaining.substr(0, end);
+        if (segment.size())
+        {
+            pattern.emplace_back(segment);
+            unbounded |= "**" == segment;
+        }
+        remaining = std::string_view::npos == end ? std::string_view{} : remaining.substr(end + 1);
     }
-    auto targetSession = targetSessionIt->second;
-    send(message, targetSession->connectionSession);
-}
 
-void ProtocolHandler::handle(uint16_t pTransactionId, RpcAccept&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
-{
-    handleRpc(pTransactionId, std::move(pMsg), pConnection);
-}
+    propertyTreeMessage.message = QueryResponse{};
+    auto& queryResponse = std::get<QueryResponse>(propertyTreeMessage.message);
 
-void ProtocolHandler::handle(uint16_t pTransactionId, RpcReject&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
-{
-    handleRpc(pTransactionId, std::move(pMsg), pConnection);
+    // Note: The levels above the visited node already point past their node, which is the parent of
+    //       the level below.
+    auto& levels = mTraversalStack;
+    auto segment = [&levels](size_t pIndex) {
+            return std::string_view(pIndex + 1 < levels.size() ? levels[pIndex + 1].first->name : levels[pIndex].second->first);
+        };
+    size_t size = 0;
+    size_t visited = 0;
+
+    queryResponse.continuation = traverseTree(*node, true, from.get(), [&](Node&, Node& pChild) {
+            if (visited++ >= QUERY_PAGE_VISITS)
+            {
+                return false;
+            }
+            if (!matchPath(pattern, 0, segment, 0, levels.size()))
+            {
+                return true;
+            }
+
+            std::string path;
+            for (auto i = 0u; i < levels.size(); i++)
+            {
+                path += path.size() ? "/" : "";
+                path += segment(i);
+            }
+
+            // Note: A match that doesn't fit starts the next page, a page always takes at least one.
+            auto matchSize = path.size() + 1 + sizeof(pChild.uuid) + sizeof(pChild.type);
+            if (pMsg.withValue)
+            {
+                matchSize += pChild.data.size() + sizeof(pChild.version) + sizeof(uint32_t);
+            }
+            if (queryResponse.matches.size() && size + matchSize >= TREE_INFO_PAGE_SIZE)
+            {
+                return false;
+            }
+            size += matchSize;
+
+            queryResponse.matches.emplace_back(QueryMatch{std::move(path), pChild.uuid, pChild.type});
+            if (pMsg.withValue)
+            {
+                queryResponse.values.emplace_back(NodeValue{pChild.version, pChild.data});
+            }
+            return true;
+        }, unbounded ? SIZE_MAX : pattern.size());
+
+    send(message, pConnection);
 }
 
-void ProtocolHandler::handle(uint16_t pTransactionId, HearbeatRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+void ProtocolHandler::handle(uint16_t pTransactionId, SetValueRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
 {
     LOGLESS_TRACE();
+    if (0 == pMsg.uuid && 4 == pMsg.data.size())
+    {
+        uint32_t value;
+        std::memcpy(&value, pMsg.data.data(), 4);
+        if (9u == value)
+        {
+            Logless("INF ProtocolHandler: terminate signal received!");
+            if (mConfig.snapshotPath.size())
+            {
+                if (-1 != mSnapshotPid)
+                {
+                    waitpid(mSnapshotPid, nullptr, 0);
+                    mSnapshotPid = -1;
+                }
+                if (!writeSnapshot(mConfig.snapshotPath))
+                {
+                    Logless("ERR ProtocolHandler: final snapshot failed errno=\"_\"", strerror(errno));
+                }
+            }
+            mTerminator();
+            return;
+        }
+    }
+
+    auto node = findNode(pMsg.uuid);
+
+    if (!node)
+    {
+        return;
+    }
+
     PropertyTreeProtocol message = PropertyTreeMessage{};
     auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
-    propertyTreeMessage.message = HearbeatResponse{};
     propertyTreeMessage.transactionId = pTransactionId;
+
+    if (node->aggregate || !matchesType(node->type, pMsg.data) || node->name.size() + pMsg.data.size() > MAX_NODE_SIZE)
+    {
+        propertyTreeMessage.message = SetValueReject{};
+        auto& setValueReject = std::get<SetValueReject>(propertyTreeMessage.message);
+        setValueReject.cause = node->aggregate ? Cause::NOT_PERMITTED :
+            !matchesType(node->type, pMsg.data) ? Cause::TYPE_MISMATCH : Cause::TOO_LARGE;
+        send(message, pConnection);
+        return;
+    }
+
+    auto previous = std::move(node->data);
+    node->data = std::move(pMsg.data);
+    node->version++;
+    mSequence++;
+    logChange(ChangeLogEntry::SET, node->uuid, 0);
+
+    propertyTreeMessage.message = SetValueAccept{};
+    if (node->ephemeral)
+    {
+        send(message, pConnection);
+    }
+    else
+    {
+        journal(Journal::RecordType::SET, node->uuid, node->version, node->data.data(), node->data.size());
+        sendDurable(message, pConnection);
+    }
+
+    publishValue(*node);
+
+    auto parentNode = node->parent.lock();
+    if (parentNode && parentNode->aggregates.size())
+    {
+        updateAggregates(*parentNode, [&](Aggregate& pAggregate) {
+                accumulate(pAggregate, *node, previous, node->data);
+            });
+    }
+}
+
+void ProtocolHandler::publishValue(Node& pNode)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = 0xFFFF;
+    propertyTreeMessage.message = UpdateNotification{};
+    auto& updateNotification = std::get<UpdateNotification>(propertyTreeMessage.message);
+    updateNotification.uuid = pNode.uuid;
+    updateNotification.version = pNode.version;
+    updateNotification.data = pNode.data;
+    updateNotification.sequence = mSequence;
+
+    std::byte buffer[ENCODE_SIZE];
+    auto msgSize = encode(message, buffer, sizeof(buffer));
+
+    for (auto i = pNode.listener.begin(); pNode.listener.end() != i; i++)
+    {
+        // Note: Resumed sessions re-point their listeners, an expired one is disconnected.
+        auto connection = i->second.lock();
+        if (!connection)
+        {
+            continue;
+        }
+
+        // Note: The sequence tells the client it has seen every change up to it, queued tree
+        //       updates must go first.
+        if (mTreeUpdatePending.count(i->first))
+        {
+            flushTreeUpdate(i->first);
+        }
+
+        send(buffer, msgSize, connection, Lane::BULK);
+    }
+}
+
+template <typename T>
+void ProtocolHandler::updateAggregates(Node& pSource, T&& pAccumulate)
+{
+    LOGLESS_TRACE();
+    auto& aggregates = pSource.aggregates;
+    aggregates.erase(std::remove_if(aggregates.begin(), aggregates.end(), [](auto& pNode) {
+            return pNode.expired();
+        }), aggregates.end());
+
+    for (auto& i : aggregates)
+    {
+        auto node = i.lock();
+        pAccumulate(*node->aggregate);
+        publishAggregate(*node);
+    }
+}
+
+void ProtocolHandler::publishAggregate(Node& pNode)
+{
+    LOGLESS_TRACE();
+    auto data = aggregateValue(*pNode.aggregate);
+    if (data.size() == pNode.data.size() && std::equal(data.begin(), data.end(), pNode.data.begin()))
+    {
+        return;
+    }
+
+    pNode.data = std::move(data);
+    pNode.version++;
+    mSequence++;
+    logChange(ChangeLogEntry::SET, pNode.uuid, 0);
+    publishValue(pNode);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, GetRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = GetReject{};
+    auto& getReject = std::get<GetReject>(propertyTreeMessage.message);
+    getReject.cause = Cause::NOT_FOUND;
+
+    auto node = findNode(pMsg.uuid);
+    if (!node)
+    {
+        send(message, pConnection);
+        return;
+    }
+
+    propertyTreeMessage.message = GetAccept{};
+    auto& getAccept = std::get<GetAccept>(propertyTreeMessage.message);
+    getAccept.version = node->version;
+    getAccept.data = node->data;
+
+    send(message, pConnection);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, SubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = SubscribeResponse{};
+    auto& subscribeResponse = std::get<SubscribeResponse>(propertyTreeMessage.message);
+    subscribeResponse.cause = Cause::NOT_FOUND;
+
+    auto node = findNode(pMsg.uuid);
+    if (!node)
+    {
+        send(message, pConnection);
+        return;
+    }
+
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt)
+    {
+        Logless("ERR ProtocolHandler: SubscribeRequest from a non signedin connection.");
+        return;
+    }
+    auto sessionId = sessionIdIt->second;
+
+    node->listener[sessionId] = pConnection;
+    mSessions.at(sessionId)->subscriptions.emplace(node->uuid);
+
+    // Note: The current value goes with the response so no update can fall between it and the subscription.
+    subscribeResponse.cause = Cause::OK;
+    subscribeResponse.version = node->version;
+    subscribeResponse.data = node->data;
+    send(message, pConnection);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, UnsubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = UnsubscribeResponse{};
+    auto& unsubscribeResponse = std::get<UnsubscribeResponse>(propertyTreeMessage.message);
+    unsubscribeResponse.cause = Cause::NOT_FOUND;
+
+    auto node = findNode(pMsg.uuid);
+    if (!node)
+    {
+        send(message, pConnection);
+        return;
+    }
+
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt)
+    {
+        return;
+    }
+    auto sessionId = sessionIdIt->second;
+
+    auto listenerIt = node->listener.find(sessionId);
+    if (node->listener.end() == listenerIt)
+    {
+        send(message, pConnection);
+        return;
+    }
+    node->listener.erase(listenerIt);
+    mSessions.at(sessionId)->subscriptions.erase(node->uuid);
+
+    unsubscribeResponse.cause = Cause::OK;
+    send(message, pConnection);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, BulkSubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = BulkSubscribeResponse{};
+    auto& bulkSubscribeResponse = std::get<BulkSubscribeResponse>(propertyTreeMessage.message);
+
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt)
+    {
+        Logless("ERR ProtocolHandler: BulkSubscribeRequest from a non signedin connection.");
+        return;
+    }
+    auto sessionId = sessionIdIt->second;
+    auto& session = *mSessions.at(sessionId);
+
+    auto& results = bulkSubscribeResponse.results;
+    results.reserve(pMsg.uuids.size());
+    size_t responseSize = 0;
+
+    for (auto uuid : pMsg.uuids)
+    {
+        if (responseSize >= BULK_RESPONSE_SIZE)
+        {
+            break;
+        }
+
+        results.emplace_back();
+        auto& result = results.back();
+        result.cause = Cause::NOT_FOUND;
+        result.version = 0;
+
+        auto node = findNode(uuid);
+        if (!node)
+        {
+            responseSize += sizeof(result);
+            continue;
+        }
+
+        node->listener[sessionId] = pConnection;
+        session.subscriptions.emplace(uuid);
+
+        result.cause = Cause::OK;
+        result.version = node->version;
+        result.data = node->data;
+        responseSize += sizeof(result) + node->data.size();
+    }
+
+    send(message, pConnection);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, BulkUnsubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = BulkUnsubscribeResponse{};
+    auto& bulkUnsubscribeResponse = std::get<BulkUnsubscribeResponse>(propertyTreeMessage.message);
+
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt)
+    {
+        return;
+    }
+    auto sessionId = sessionIdIt->second;
+    auto& session = *mSessions.at(sessionId);
+
+    auto& causes = bulkUnsubscribeResponse.causes;
+    causes.reserve(pMsg.uuids.size());
+
+    for (auto uuid : pMsg.uuids)
+    {
+        auto foundIt = mTree.find(uuid);
+        if (mTree.end() == foundIt || !foundIt->second->listener.erase(sessionId))
+        {
+            causes.emplace_back(Cause::NOT_FOUND);
+            continue;
+        }
+        session.subscriptions.erase(uuid);
+        causes.emplace_back(Cause::OK);
+    }
+
     send(message, pConnection);
 }
 
+void ProtocolHandler::handle(uint16_t pTransactionId, DeleteRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = DeleteResponse{};
+    auto& deleteResponse = std::get<DeleteResponse>(propertyTreeMessage.message);
+    deleteResponse.cause = Cause::NOT_FOUND;
+
+    auto node = findNode(pMsg.uuid);
+    if (!node)
+    {
+        send(message, pConnection);
+        return;
+    }
+
+    auto parentNode = node->parent.lock();
+    if (!parentNode)
+    {
+        deleteResponse.cause = Cause::NOT_PERMITTED;
+        send(message, pConnection);
+        return;
+    }
+
+    loadChildren(*node);
+    if (node->children.size() && !pMsg.recursive)
+    {
+        deleteResponse.cause = Cause::NOT_EMPTY;
+        send(message, pConnection);
+        return;
+    }
+
+    parentNode->children.erase(node->name);
+    mSequence++;
+
+    deleteResponse.cause = Cause::OK;
+    if (node->ephemeral)
+    {
+        send(message, pConnection);
+    }
+    else
+    {
+        journal(Journal::RecordType::DELETE, node->uuid, 0, nullptr, 0);
+        sendDurable(message, pConnection);
+    }
+
+    removeSubtree(*parentNode, node);
+}
+
+void ProtocolHandler::removeSubtree(Node& pParent, std::shared_ptr<Node> pNode)
+{
+    LOGLESS_TRACE();
+    // Note: pNode keeps the whole subtree alive until every node is unregistered.
+    std::vector<std::pair<Node*, Node*>> removed;
+    removed.emplace_back(&pParent, pNode.get());
+
+    for (size_t i = 0; i < removed.size(); i++)
+    {
+        auto node = removed[i].second;
+        for (auto& child : node->children)
+        {
+            removed.emplace_back(node, child.second.get());
+        }
+    }
+
+    for (auto& i : removed)
+    {
+        queueTreeDelete(*i.first, *i.second);
+        logChange(ChangeLogEntry::DELETE, i.second->uuid, i.first->uuid);
+
+        for (auto& listener : i.second->listener)
+        {
+            auto sessionIt = mSessions.find(listener.first);
+            if (mSessions.end() != sessionIt)
+            {
+                sessionIt->second->subscriptions.erase(i.second->uuid);
+            }
+        }
+
+        for (auto sessionId : i.second->treeListener)
+        {
+            auto sessionIt = mSessions.find(sessionId);
+            if (mSessions.end() != sessionIt)
+            {
+                sessionIt->second->interests.erase(i.second->uuid);
+            }
+        }
+
+        if (i.second->ephemeral)
+        {
+            auto ownerIt = mSessions.find(i.second->sessionId);
+            if (mSessions.end() != ownerIt)
+            {
+                ownerIt->second->ephemerals.erase(i.second->uuid);
+            }
+        }
+
+        for (auto sessionId : i.second->providers)
+        {
+            auto sessionIt = mSessions.find(sessionId);
+            if (mSessions.end() != sessionIt)
+            {
+                sessionIt->second->providing.erase(i.second->uuid);
+            }
+        }
+
+        mTree.erase(i.second->uuid);
+    }
+
+    if (pParent.aggregates.size())
+    {
+        updateAggregates(pParent, [&](Aggregate& pAggregate) {
+                accumulate(pAggregate, *pNode, pNode->data, Buffer{});
+            });
+    }
+
+    // Note: An aggregate can't outlive its source, the ones outside the removed subtree go with it
+    //       as part of the same change.
+    std::vector<std::shared_ptr<Node>> orphans;
+    for (auto& i : removed)
+    {
+        for (auto& aggregate : i.second->aggregates)
+        {
+            auto node = aggregate.lock();
+            if (node && mTree.count(node->uuid))
+            {
+                orphans.emplace_back(std::move(node));
+            }
+        }
+    }
+
+    for (auto& orphan : orphans)
+    {
+        auto parentNode = orphan->parent.lock();
+        if (parentNode && mTree.count(orphan->uuid))
+        {
+            parentNode->children.erase(orphan->name);
+            removeSubtree(*parentNode, orphan);
+        }
+    }
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, RpcRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol messageReject = PropertyTreeMessage{};
+    auto& propertyTreeMessageReject = std::get<PropertyTreeMessage>(messageReject);
+    propertyTreeMessageReject.message = RpcReject{};
+    propertyTreeMessageReject.transactionId = pTransactionId;
+    auto& rpcReject = std::get<RpcReject>(propertyTreeMessageReject.message);
+
+    auto node = findNode(pMsg.uuid);
+    if (!node)
+    {
+        rpcReject.cause = Cause::NOT_FOUND;
+        send(messageReject, pConnection);
+        return;
+    }
+
+    auto sourceSessionIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sourceSessionIt)
+    {
+        return;
+    }
+    auto sourceSessionId = sourceSessionIt->second;
+    auto sessionId = selectProvider(*node);
+    if (NO_SESSION == sessionId)
+    {
+        rpcReject.cause = Cause::NO_HANDLER;
+        send(messageReject, pConnection);
+        return;
+    }
+    auto& targetSession = *mSessions.at(sessionId);
+    auto targetConnection = targetSession.connectionSession;
+
+    if (targetSession.incomingCalls.size() >= mConfig.rpcInFlightLimit)
+    {
+        rpcReject.cause = Cause::BUSY;
+        send(messageReject, pConnection);
+        return;
+    }
+
+    // Note: The least loaded provider is picked, so the limit is only hit when all of them are full.
+    // Note: The provider is addressed by callId, transactionId stays out of its own transaction space.
+    auto callId = ++mCallIdCtr;
+    uint64_t timeoutTicks = toTicks(mConfig.rpcTimeout);
+    auto timer = mRpcWheel.schedule(timeoutTicks, callId);
+    mPendingCalls.emplace(callId, PendingCall{sourceSessionId, pTransactionId, sessionId, timer, pMsg.window});
+    targetSession.incomingCalls.emplace(callId);
+    mSessions.at(sourceSessionId)->outgoingCalls.emplace(callId);
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = 0xFFFF;
+    pMsg.callId = callId;
+    propertyTreeMessage.message = std::move(pMsg);
+
+    send(message, targetConnection);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, RpcPartial&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    auto callIt = mPendingCalls.find(pMsg.callId);
+    if (mPendingCalls.end() == callIt)
+    {
+        Logless("DBG ProtocolHandler: partial of unknown or expired call _", pMsg.callId);
+        return;
+    }
+    auto& call = callIt->second;
+
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt || call.targetSessionId != sessionIdIt->second)
+    {
+        Logless("ERR ProtocolHandler: partial of call _ from a session it wasn't forwarded to.", pMsg.callId);
+        return;
+    }
+
+    // Note: The caller only buffers what it granted, a provider ignoring the window ends the call.
+    if (!call.credit)
+    {
+        Logless("ERR ProtocolHandler: partial of call _ exceeds the window.", pMsg.callId);
+        failCall(callIt, Cause::NOT_PERMITTED);
+        return;
+    }
+    call.credit--;
+    restartCallTimer(call, pMsg.callId);
+
+    // Note: Partials go on the lane of the final response so that they arrive before it.
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = call.sourceTrId;
+    propertyTreeMessage.message = std::move(pMsg);
+
+    auto sourceSessionIt = mSessions.find(call.sourceSessionId);
+    if (mSessions.end() == sourceSessionIt)
+    {
+        return;
+    }
+    send(message, sourceSessionIt->second->connectionSession);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, RpcCredit&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    auto callIt = mPendingCalls.find(pMsg.callId);
+    if (mPendingCalls.end() == callIt)
+    {
+        return;
+    }
+    auto& call = callIt->second;
+
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt || call.sourceSessionId != sessionIdIt->second)
+    {
+        Logless("ERR ProtocolHandler: credit for call _ from a session that didn't make it.", pMsg.callId);
+        return;
+    }
+
+    call.credit += pMsg.credit;
+    restartCallTimer(call, pMsg.callId);
+
+    auto targetSessionIt = mSessions.find(call.targetSessionId);
+    if (mSessions.end() == targetSessionIt)
+    {
+        return;
+    }
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = 0xFFFF;
+    propertyTreeMessage.message = std::move(pMsg);
+    send(message, targetSessionIt->second->connectionSession, Lane::CONTROL);
+}
+
+void ProtocolHandler::restartCallTimer(PendingCall& pCall, uint64_t pCallId)
+{
+    // Note: A streaming call only times out when it stops making progress.
+    mRpcWheel.cancel(pCall.timer);
+    uint64_t timeoutTicks = toTicks(mConfig.rpcTimeout);
+    pCall.timer = mRpcWheel.schedule(timeoutTicks, pCallId);
+}
+
+uint32_t ProtocolHandler::selectProvider(Node& pNode)
+{
+    if (pNode.providers.empty())
+    {
+        auto ownerIt = mSessions.find(pNode.sessionId);
+        if (mSessions.end() == ownerIt || !ownerIt->second->connectionSession)
+        {
+            return NO_SESSION;
+        }
+        return pNode.sessionId;
+    }
+
+    // Note: Least outstanding calls first, scanning from nextProvider breaks ties round-robin.
+    auto count = pNode.providers.size();
+    auto selected = NO_SESSION;
+    size_t selectedIndex = 0;
+    size_t least = SIZE_MAX;
+    for (size_t i = 0; i < count; i++)
+    {
+        auto index = (pNode.nextProvider + i) % count;
+        auto sessionIt = mSessions.find(pNode.providers[index]);
+        if (mSessions.end() == sessionIt || !sessionIt->second->connectionSession)
+        {
+            continue;
+        }
+
+        auto outstanding = sessionIt->second->incomingCalls.size();
+        if (outstanding < least)
+        {
+            least = outstanding;
+            selected = sessionIt->first;
+            selectedIndex = index;
+        }
+    }
+
+    pNode.nextProvider = (selectedIndex + 1) % count;
+    return selected;
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, ProviderRegisterRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = ProviderRegisterResponse{};
+    auto& providerRegisterResponse = std::get<ProviderRegisterResponse>(propertyTreeMessage.message);
+    providerRegisterResponse.cause = Cause::NOT_FOUND;
+
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt)
+    {
+        Logless("ERR ProtocolHandler: ProviderRegisterRequest from a non signedin connection.");
+        return;
+    }
+    auto sessionId = sessionIdIt->second;
+
+    auto node = findNode(pMsg.uuid);
+    if (!node)
+    {
+        send(message, pConnection);
+        return;
+    }
+
+    providerRegisterResponse.cause = Cause::OK;
+    if (mSessions.at(sessionId)->providing.emplace(node->uuid).second)
+    {
+        node->providers.emplace_back(sessionId);
+    }
+
+    send(message, pConnection);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, ProviderUnregisterRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = pTransactionId;
+    propertyTreeMessage.message = ProviderUnregisterResponse{};
+    auto& providerUnregisterResponse = std::get<ProviderUnregisterResponse>(propertyTreeMessage.message);
+    providerUnregisterResponse.cause = Cause::NOT_FOUND;
+
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt)
+    {
+        Logless("ERR ProtocolHandler: ProviderUnregisterRequest from a non signedin connection.");
+        return;
+    }
+    auto sessionId = sessionIdIt->second;
+
+    auto node = findNode(pMsg.uuid);
+    if (!node || !mSessions.at(sessionId)->providing.erase(node->uuid))
+    {
+        send(message, pConnection);
+        return;
+    }
+
+    removeProvider(*node, sessionId);
+    providerUnregisterResponse.cause = Cause::OK;
+    send(message, pConnection);
+}
+
+void ProtocolHandler::removeProvider(Node& pNode, uint32_t pSessionId)
+{
+    auto& providers = pNode.providers;
+    auto providerIt = std::find(providers.begin(), providers.end(), pSessionId);
+    if (providers.end() == providerIt)
+    {
+        return;
+    }
+    providers.erase(providerIt);
+    if (pNode.nextProvider >= providers.size())
+    {
+        pNode.nextProvider = 0;
+    }
+}
+
+template<typename T>
+void ProtocolHandler::handleRpc(uint16_t pTransactionId, T&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    auto callIt = mPendingCalls.find(pMsg.callId);
+    if (mPendingCalls.end() == callIt)
+    {
+        Logless("DBG ProtocolHandler: response to unknown or expired call _", pMsg.callId);
+        return;
+    }
+    auto call = callIt->second;
+
+    auto sessionIdIt = mConnectionToSessionId.find(pConnection.get());
+    if (mConnectionToSessionId.end() == sessionIdIt || call.targetSessionId != sessionIdIt->second)
+    {
+        Logless("ERR ProtocolHandler: response to call _ from a session it wasn't forwarded to.", pMsg.callId);
+        return;
+    }
+
+    endCall(callIt);
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.message = std::move(pMsg);
+    propertyTreeMessage.transactionId = call.sourceTrId;
+
+    auto targetSessionIt =  mSessions.find(call.sourceSessionId);
+    if (mSessions.end() == targetSessionIt)
+    {
+        return;
+    }
+    auto targetSession = targetSessionIt->second;
+    send(message, targetSession->connectionSession);
+}
+
+void ProtocolHandler::endCall(std::unordered_map<uint64_t, PendingCall>::iterator pCall)
+{
+    auto& call = pCall->second;
+    if (TimerWheel::INVALID != call.timer)
+    {
+        mRpcWheel.cancel(call.timer);
+    }
+
+    auto providerIt = mSessions.find(call.targetSessionId);
+    if (mSessions.end() != providerIt)
+    {
+        providerIt->second->incomingCalls.erase(pCall->first);
+    }
+
+    auto callerIt = mSessions.find(call.sourceSessionId);
+    if (mSessions.end() != callerIt)
+    {
+        callerIt->second->outgoingCalls.erase(pCall->first);
+    }
+
+    mPendingCalls.erase(pCall);
+}
+
+void ProtocolHandler::failCall(std::unordered_map<uint64_t, PendingCall>::iterator pCall, Cause pCause)
+{
+    auto callId = pCall->first;
+    auto call = pCall->second;
+    endCall(pCall);
+
+    auto sourceSessionIt = mSessions.find(call.sourceSessionId);
+    if (mSessions.end() == sourceSessionIt)
+    {
+        return;
+    }
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = call.sourceTrId;
+    propertyTreeMessage.message = RpcReject{};
+    auto& rpcReject = std::get<RpcReject>(propertyTreeMessage.message);
+    rpcReject.cause = pCause;
+    rpcReject.callId = callId;
+    send(message, sourceSessionIt->second->connectionSession);
+}
+
+void ProtocolHandler::expireCall(uint64_t pCallId)
+{
+    auto callIt = mPendingCalls.find(pCallId);
+    if (mPendingCalls.end() == callIt)
+    {
+        return;
+    }
+    Logless("WRN ProtocolHandler: call _ to session _ timed out.", pCallId, callIt->second.targetSessionId);
+    callIt->second.timer = TimerWheel::INVALID;
+    failCall(callIt, Cause::TIMEOUT);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, RpcAccept&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    handleRpc(pTransactionId, std::move(pMsg), pConnection);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, RpcReject&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    handleRpc(pTransactionId, std::move(pMsg), pConnection);
+}
+
+void ProtocolHandler::handle(uint16_t pTransactionId, HearbeatRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    LOGLESS_TRACE();
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.message = HearbeatResponse{};
+    propertyTreeMessage.transactionId = pTransactionId;
+    send(message, pConnection, Lane::CONTROL);
+}
+
+void ProtocolHandler::queueTreeAdd(const std::unordered_set<uint32_t>& pSessionIds, const NamedNode& pNode, uint32_t pExcludedSessionId)
+{
+    LOGLESS_TRACE();
+    for (auto i : pSessionIds)
+    {
+        if (pExcludedSessionId == i)
+        {
+            continue;
+        }
+        auto sessionIt = mSessions.find(i);
+        if (mSessions.end() == sessionIt)
+        {
+            continue;
+        }
+        auto& session = *sessionIt->second;
+        session.pendingTreeAdd.emplace(pNode.uuid, pNode);
+        session.pendingTreeUpdateSize += pendingTreeAddSize(pNode);
+        mTreeUpdatePending.emplace(i);
+
+        if (session.pendingTreeUpdateSize >= TREE_UPDATE_FLUSH_SIZE)
+        {
+            flushTreeUpdate(i, true);
+        }
+    }
+}
+
+void ProtocolHandler::queueTreeDelete(Node& pParent, Node& pNode)
+{
+    // Note: Sessions that know about the deleted node are the ones that loaded its parent or
+    //       its own children, and its subscribers.
+    for (auto i : pParent.treeListener)
+    {
+        queueTreeDelete(i, pNode.uuid);
+    }
+
+    for (auto i : pNode.treeListener)
+    {
+        if (!pParent.treeListener.count(i))
+        {
+            queueTreeDelete(i, pNode.uuid);
+        }
+    }
+
+    for (auto& i : pNode.listener)
+    {
+        if (!pParent.treeListener.count(i.first) && !pNode.treeListener.count(i.first))
+        {
+            queueTreeDelete(i.first, pNode.uuid);
+        }
+    }
+}
+
+void ProtocolHandler::queueTreeDelete(uint32_t pSessionId, uint64_t pUuid)
+{
+    auto sessionIt = mSessions.find(pSessionId);
+    if (mSessions.end() == sessionIt)
+    {
+        return;
+    }
+    auto& session = *sessionIt->second;
+
+    // Note: A create and delete within the same window cancel out.
+    auto addIt = session.pendingTreeAdd.find(pUuid);
+    if (session.pendingTreeAdd.end() != addIt)
+    {
+        session.pendingTreeUpdateSize -= pendingTreeAddSize(addIt->second);
+        session.pendingTreeAdd.erase(addIt);
+        return;
+    }
+
+    session.pendingTreeDelete.emplace_back(pUuid);
+    session.pendingTreeUpdateSize += sizeof(pUuid);
+    mTreeUpdatePending.emplace(pSessionId);
+
+    if (session.pendingTreeUpdateSize >= TREE_UPDATE_FLUSH_SIZE)
+    {
+        flushTreeUpdate(pSessionId, true);
+    }
+}
+
+void ProtocolHandler::flushTreeUpdate(uint32_t pSessionId, bool pPartial)
+{
+    LOGLESS_TRACE();
+    auto sessionIt = mSessions.find(pSessionId);
+    if (mSessions.end() == sessionIt)
+    {
+        return;
+    }
+    auto& session = *sessionIt->second;
+
+    if (!session.pendingTreeAdd.size() && !session.pendingTreeDelete.size())
+    {
+        return;
+    }
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = 0xFFFF;
+    propertyTreeMessage.message = TreeUpdateNotification{};
+    auto& treeUpdateNotification = std::get<TreeUpdateNotification>(propertyTreeMessage.message);
+
+    treeUpdateNotification.nodeToAddList.reserve(session.pendingTreeAdd.size());
+    for (auto& i : session.pendingTreeAdd)
+    {
+        treeUpdateNotification.nodeToAddList.emplace_back(std::move(i.second));
+    }
+    treeUpdateNotification.nodeToDelete = std::move(session.pendingTreeDelete);
+    // Note: The client resumes from the highest sequence it saw. Changes that share the current
+    //       sequence may still be queued after a partial flush, so it must not claim it yet.
+    treeUpdateNotification.sequence = pPartial ? mSequence - 1 : mSequence;
+
+    session.pendingTreeAdd.clear();
+    session.pendingTreeDelete.clear();
+    session.pendingTreeUpdateSize = 0;
+
+    send(message, session.connectionSession, Lane::BULK);
+}
+
+void ProtocolHandler::addTreeListener(Node& pNode, uint32_t pSessionId)
+{
+    if (pNode.treeListener.emplace(pSessionId).second)
+    {
+        mSessions.at(pSessionId)->interests.emplace(pNode.uuid);
+    }
+}
+
+void ProtocolHandler::expireSessions()
+{
+    auto now = std::chrono::steady_clock::now();
+    while (mDisconnectedSessions.size() && now - mDisconnectedSessions.front().first >= mConfig.sessionGracePeriod)
+    {
+        auto disconnected = mDisconnectedSessions.front();
+        mDisconnectedSessions.pop_front();
+
+        // Note: Sessions resumed meanwhile, or disconnected again later, have a newer entry or none.
+        auto sessionIt = mSessions.find(disconnected.second);
+        if (mSessions.end() == sessionIt || sessionIt->second->connectionSession ||
+            sessionIt->second->disconnectTime != disconnected.first)
+        {
+            continue;
+        }
+
+        teardownSession(disconnected.second);
+    }
+}
+
+void ProtocolHandler::teardownSession(uint32_t pSessionId)
+{
+    LOGLESS_TRACE();
+    auto sessionIt = mSessions.find(pSessionId);
+    if (mSessions.end() == sessionIt)
+    {
+        return;
+    }
+    auto& session = *sessionIt->second;
+
+    // Note: Ephemeral nodes end with their session, the deletions of all of them are queued together
+    //       and go out as one TreeUpdateNotification per interested session on the next tick.
+    size_t ephemerals = session.ephemerals.size();
+    if (ephemerals)
+    {
+        mSequence++;
+        auto owned = std::move(session.ephemerals);
+        session.ephemerals.clear();
+        for (auto uuid : owned)
+        {
+            auto nodeIt = mTree.find(uuid);
+            if (mTree.end() == nodeIt)
+            {
+                continue;
+            }
+            auto node = nodeIt->second;
+            auto parentNode = node->parent.lock();
+            if (!parentNode)
+            {
+                continue;
+            }
+            parentNode->children.erase(node->name);
+            removeSubtree(*parentNode, node);
+        }
+    }
+
+    // Note: Rough estimate of the heap the session held, hash nodes carry a next pointer and the hash.
+    constexpr size_t HASH_NODE_OVERHEAD = 2*sizeof(void*);
+    size_t reclaimed = sizeof(Session) + HASH_NODE_OVERHEAD;
+
+    size_t listeners = 0;
+    for (auto uuid : session.subscriptions)
+    {
+        auto nodeIt = mTree.find(uuid);
+        if (mTree.end() != nodeIt)
+        {
+            listeners += nodeIt->second->listener.erase(pSessionId);
+        }
+    }
+    reclaimed += listeners * (sizeof(decltype(Node::listener)::value_type) + HASH_NODE_OVERHEAD);
+    reclaimed += session.subscriptions.size() * (sizeof(uint64_t) + HASH_NODE_OVERHEAD);
+
+    size_t treeListeners = 0;
+    for (auto uuid : session.interests)
+    {
+        auto nodeIt = mTree.find(uuid);
+        if (mTree.end() != nodeIt)
+        {
+            treeListeners += nodeIt->second->treeListener.erase(pSessionId);
+        }
+    }
+    reclaimed += treeListeners * (sizeof(uint32_t) + HASH_NODE_OVERHEAD);
+    reclaimed += session.interests.size() * (sizeof(uint64_t) + HASH_NODE_OVERHEAD);
+
+    // Note: Calls the session was serving were failed on disconnect, the answers to its own calls
+    //       have nowhere to go.
+    size_t calls = session.outgoingCalls.size();
+    while (session.outgoingCalls.size())
+    {
+        auto callId = *session.outgoingCalls.begin();
+        auto callIt = mPendingCalls.find(callId);
+        if (mPendingCalls.end() == callIt)
+        {
+            Logless("ERR ProtocolHandler: session _ waits for unknown call _.", pSessionId, callId);
+            session.outgoingCalls.erase(callId);
+            continue;
+        }
+        endCall(callIt);
+    }
+    reclaimed += calls * (sizeof(decltype(mPendingCalls)::value_type) + HASH_NODE_OVERHEAD);
+
+    for (auto& i : session.pendingTreeAdd)
+    {
+        reclaimed += sizeof(i) + i.second.name.size();
+    }
+    reclaimed += session.pendingTreeDelete.size() * sizeof(uint64_t);
+
+    for (auto uuid : session.providing)
+    {
+        auto nodeIt = mTree.find(uuid);
+        if (mTree.end() != nodeIt)
+        {
+            removeProvider(*nodeIt->second, pSessionId);
+        }
+    }
+
+    disarmLiveness(session);
+    mSessionTokens.erase(session.token);
+    mTreeUpdatePending.erase(pSessionId);
+    mSessions.erase(sessionIt);
+
+    mReclaimedSize += reclaimed;
+    Logless("INF ProtocolHandler: session _ torn down ephemerals=_ listeners=_ treeListeners=_ calls=_ reclaimed=_ bytes",
+        pSessionId, ephemerals, listeners, treeListeners, calls, reclaimed);
+}
+
+uint64_t ProtocolHandler::reclaimedSize() const
+{
+    return mReclaimedSize;
+}
+
+uint64_t ProtocolHandler::toTicks(std::chrono::milliseconds pDuration) const
+{
+    // Note: Rounded up, a duration shorter than a tick still takes one instead of disabling the timer.
+    return (pDuration.count() + mConfig.tickPeriod.count() - 1) / mConfig.tickPeriod.count();
+}
+
+void ProtocolHandler::armLiveness(Session& pSession, uint32_t pSessionId)
+{
+    disarmLiveness(pSession);
+    pSession.lastActivity = mLivenessWheel.now();
+    pSession.probed = false;
+
+    auto probeTicks = toTicks(mConfig.probePeriod);
+    auto idleTicks = toTicks(mConfig.idleTimeout);
+    if (probeTicks || idleTicks)
+    {
+        pSession.livenessTimer = mLivenessWheel.schedule(probeTicks ? probeTicks : idleTicks, pSessionId);
+    }
+}
+
+void ProtocolHandler::disarmLiveness(Session& pSession)
+{
+    if (TimerWheel::INVALID != pSession.livenessTimer)
+    {
+        mLivenessWheel.cancel(pSession.livenessTimer);
+        pSession.livenessTimer = TimerWheel::INVALID;
+    }
+}
+
+void ProtocolHandler::checkLiveness(uint32_t pSessionId)
+{
+    LOGLESS_TRACE();
+    auto sessionIt = mSessions.find(pSessionId);
+    if (mSessions.end() == sessionIt)
+    {
+        return;
+    }
+    auto& session = *sessionIt->second;
+    session.livenessTimer = TimerWheel::INVALID;
+
+    if (!session.connectionSession)
+    {
+        return;
+    }
+
+    // Note: Activity only updates lastActivity, the timer is pushed back lazily when it fires.
+    uint64_t probeTicks = toTicks(mConfig.probePeriod);
+    uint64_t idleTicks = toTicks(mConfig.idleTimeout);
+    uint64_t idle = mLivenessWheel.now() - session.lastActivity;
+
+    if (idleTicks && idle >= idleTicks)
+    {
+        Logless("WRN ProtocolHandler: session _ idle for _ ticks, disconnecting.", pSessionId, idle);
+        auto connection = session.connectionSession;
+        connection->disconnect();
+        return;
+    }
+
+    if (probeTicks && !session.probed && idle >= probeTicks)
+    {
+        PropertyTreeProtocol message = PropertyTreeMessage{};
+        auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+        propertyTreeMessage.message = HearbeatRequest{};
+        propertyTreeMessage.transactionId = 0xFFFF;
+        send(message, session.connectionSession, Lane::CONTROL);
+        session.probed = true;
+    }
+
+    uint64_t deadline = idleTicks ? idleTicks : idle + probeTicks;
+    if (probeTicks && !session.probed)
+    {
+        deadline = probeTicks;
+    }
+    else if (!idleTicks)
+    {
+        // Note: Probes only keep the connection alive, the next one goes out a period later.
+        session.probed = false;
+    }
+
+    session.livenessTimer = mLivenessWheel.schedule(deadline - idle, pSessionId);
+}
+
+void ProtocolHandler::logChange(ChangeLogEntry::Type pType, uint64_t pUuid, uint64_t pParentUuid)
+{
+    mChangeLog.emplace_back(ChangeLogEntry{mSequence, pUuid, pParentUuid, pType});
+    if (mChangeLog.size() > mConfig.changeLogSize)
+    {
+        mChangeLogFloor = mChangeLog.front().sequence;
+        mChangeLog.pop_front();
+    }
+}
+
+void ProtocolHandler::resync(uint32_t pSessionId, uint64_t pSequence)
+{
+    LOGLESS_TRACE();
+    auto& session = *mSessions.at(pSessionId);
+
+    PropertyTreeProtocol message = PropertyTreeMessage{};
+    auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+    propertyTreeMessage.transactionId = 0xFFFF;
+    propertyTreeMessage.message = TreeUpdateNotification{};
+    auto& treeUpdateNotification = std::get<TreeUpdateNotification>(propertyTreeMessage.message);
+    // Note: Replayed changes keep the client's sequence, it only moves on with ResumeAccept.
+    treeUpdateNotification.sequence = pSequence;
+    size_t treeUpdateSize = 0;
+
+    std::unordered_set<uint64_t> deleted;
+    std::unordered_set<uint64_t> updated;
+
+    auto first = std::upper_bound(mChangeLog.begin(), mChangeLog.end(), pSequence, [](uint64_t pSequence, const ChangeLogEntry& pEntry) {
+            return pSequence < pEntry.sequence;
+        });
+
+    for (auto i = first; mChangeLog.end() != i; i++)
+    {
+        if (ChangeLogEntry::SET == i->type)
+        {
+            if (session.subscriptions.count(i->uuid))
+            {
+                updated.emplace(i->uuid);
+            }
+            continue;
+        }
+
+        auto parentIt = mTree.find(i->parentUuid);
+        bool known = mTree.end() != parentIt && parentIt->second->treeListener.count(pSessionId);
+
+        if (ChangeLogEntry::ADD == i->type)
+        {
+            auto nodeIt = mTree.find(i->uuid);
+            if (!known || mTree.end() == nodeIt)
+            {
+                continue;
+            }
+            auto& name = nodeIt->second->name;
+            treeUpdateNotification.nodeToAddList.emplace_back(NamedNode{name, i->uuid, i->parentUuid, nodeIt->second->type});
+            treeUpdateSize += sizeof(NamedNode) + name.size();
+        }
+        else
+        {
+            // Note: Descendants of a deleted node follow it in the log.
+            if (!known && !deleted.count(i->parentUuid))
+            {
+                continue;
+            }
+            deleted.emplace(i->uuid);
+            treeUpdateNotification.nodeToDelete.emplace_back(i->uuid);
+            treeUpdateSize += sizeof(uint64_t);
+        }
+
+        if (treeUpdateSize >= TREE_UPDATE_FLUSH_SIZE)
+        {
+            send(message, session.connectionSession);
+            treeUpdateNotification.nodeToAddList.clear();
+            treeUpdateNotification.nodeToDelete.clear();
+            treeUpdateSize = 0;
+        }
+    }
+
+    if (treeUpdateNotification.nodeToAddList.size() || treeUpdateNotification.nodeToDelete.size())
+    {
+        send(message, session.connectionSession);
+    }
+
+    propertyTreeMessage.message = UpdateNotification{};
+    auto& updateNotification = std::get<UpdateNotification>(propertyTreeMessage.message);
+    updateNotification.sequence = pSequence;
+    for (auto uuid : updated)
+    {
+        auto nodeIt = mTree.find(uuid);
+        if (mTree.end() == nodeIt)
+        {
+            continue;
+        }
+        updateNotification.uuid = uuid;
+        updateNotification.version = nodeIt->second->version;
+        updateNotification.data = nodeIt->second->data;
+        send(message, session.connectionSession);
+    }
+}
+
+void ProtocolHandler::checkSnapshot()
+{
+    if (-1 != mSnapshotPid)
+    {
+        int status;
+        auto res = waitpid(mSnapshotPid, &status, WNOHANG);
+        if (0 == res)
+        {
+            return;
+        }
+        mSnapshotPid = -1;
+
+        if (-1 != res && WIFEXITED(status) && 0 == WEXITSTATUS(status))
+        {
+            mSnapshotSequence = mSnapshotPendingSequence;
+            Logless("INF ProtocolHandler: snapshot written sequence=_", mSnapshotSequence);
+            if (mJournal)
+            {
+                mJournal->release();
+            }
+        }
+        else
+        {
+            Logless("ERR ProtocolHandler: snapshot failed status=_", status);
+        }
+    }
+
+    if (!mConfig.snapshotPath.size() || !mConfig.snapshotPeriod.count() || mSnapshotSequence == mSequence)
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - mSnapshotTime < mConfig.snapshotPeriod)
+    {
+        return;
+    }
+    mSnapshotTime = now;
+
+    startSnapshot();
+}
+
+void ProtocolHandler::startSnapshot()
+{
+    LOGLESS_TRACE();
+    // Note: Other threads may hold locks at fork time, so the image is built here and the child only
+    //       writes it out while the reactor carries on.
+    auto image = buildSnapshot();
+    auto tmpPath = mConfig.snapshotPath + ".tmp";
+    auto pid = fork();
+    if (-1 == pid)
+    {
+        Logless("ERR ProtocolHandler: snapshot fork failed errno=\"_\"", strerror(errno));
+        return;
+    }
+
+    if (0 == pid)
+    {
+        _exit(writeImage(mConfig.snapshotPath.c_str(), tmpPath.c_str(), image) ? 0 : 1);
+    }
+
+    mSnapshotPid = pid;
+    mSnapshotPendingSequence = mSequence;
+
+    if (mJournal)
+    {
+        mJournal->rotate();
+    }
+}
+
+std::vector<std::byte> ProtocolHandler::buildSnapshot()
+{
+    LOGLESS_TRACE();
+    // SnapshotEntry: node to persist, either materialized or still only in the mapped image
+    // Note: The children of an entry are childCount uuids from childBegin in childUuids.
+    struct SnapshotEntry
+    {
+        uint64_t uuid;
+        uint64_t parentUuid;
+        const Node* node;
+        const TreeImage::ImageNode* image;
+        size_t childBegin;
+        uint32_t childCount;
+    };
+
+    // Note: The image needs the node table sorted by uuid and the children of every node
+    //       contiguous, so the whole tree is collected first. Subtrees never materialized are
+    //       copied from the mapped image as is instead of being loaded.
+    std::vector<SnapshotEntry> entries;
+    std::vector<uint64_t> childUuids;
+    std::unordered_set<uint64_t> imageSeen;
+    entries.push_back({ROOT_UUID, ROOT_UUID, mTree.at(ROOT_UUID).get(), nullptr, 0, 0});
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        auto uuid = entries[i].uuid;
+        auto node = entries[i].node;
+        auto image = entries[i].image;
+        auto childBegin = childUuids.size();
+
+        if (node && !node->imageChildren)
+        {
+            for (auto& child : node->children)
+            {
+                if (child.second->ephemeral)
+                {
+                    continue;
+                }
+                entries.push_back({child.second->uuid, uuid, child.second.get(), nullptr, 0, 0});
+                childUuids.push_back(child.second->uuid);
+            }
+        }
+        else
+        {
+            if (!image)
+            {
+                image = mImage->find(uuid);
+            }
+            if (!image || !mImage->valid(*image))
+            {
+                Logless("ERR ProtocolHandler: snapshot image node _ is corrupt, children not persisted.", uuid);
+                image = nullptr;
+            }
+
+            for (auto c = 0u; image && c < image->childCount; c++)
+            {
+                auto& imageChild = mImage->child(*image, c);
+                if (!mImage->valid(imageChild) || imageChild.parentUuid != uuid || !imageSeen.emplace(imageChild.uuid).second)
+                {
+                    Logless("ERR ProtocolHandler: snapshot image child _ of _ is corrupt, skipped.", imageChild.uuid, uuid);
+                    continue;
+                }
+                entries.push_back({imageChild.uuid, uuid, nullptr, &imageChild, 0, 0});
+                childUuids.push_back(imageChild.uuid);
+            }
+        }
+
+        entries[i].childBegin = childBegin;
+        entries[i].childCount = childUuids.size() - childBegin;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const SnapshotEntry& pLeft, const SnapshotEntry& pRight) {
+            return pLeft.uuid < pRight.uuid;
+        });
+
+    std::unordered_map<uint64_t, uint32_t> indices;
+    indices.reserve(entries.size());
+    for (auto i = 0u; i < entries.size(); i++)
+    {
+        indices.emplace(entries[i].uuid, i);
+    }
+
+    auto name = [this](const SnapshotEntry& pEntry) {
+            return pEntry.node ? std::string_view(pEntry.node->name) : mImage->name(*pEntry.image);
+        };
+    auto data = [this](const SnapshotEntry& pEntry) {
+            return pEntry.node ? std::string_view((const char*)pEntry.node->data.data(), pEntry.node->data.size())
+                : std::string_view((const char*)mImage->data(*pEntry.image), pEntry.image->dataSize);
+        };
+
+    TreeImage::ImageHeader header{};
+    header.magic = TreeImage::MAGIC;
+    header.sequence = mSequence;
+    header.uuidCtr = mUuidCtr;
+    header.nodeCount = entries.size();
+    header.childrenCount = childUuids.size();
+    header.nodesOffset = sizeof(header);
+    header.childrenOffset = header.nodesOffset + header.nodeCount*sizeof(TreeImage::ImageNode);
+    header.blobOffset = header.childrenOffset + header.childrenCount*sizeof(uint32_t);
+
+    size_t blobSize = 0;
+    for (auto& entry : entries)
+    {
+        blobSize += name(entry).size() + data(entry).size();
+    }
+
+    std::vector<std::byte> image;
+    image.reserve(header.blobOffset + blobSize);
+    auto write = [&image](const void* pData, size_t pSize) {
+            image.insert(image.end(), (const std::byte*)pData, (const std::byte*)pData + pSize);
+        };
+
+    write(&header, sizeof(header));
+
+    uint64_t blobOffset = 0;
+    uint32_t childIndex = 0;
+    for (auto& entry : entries)
+    {
+        auto nameSize = name(entry).size();
+        auto dataSize = data(entry).size();
+        auto version = entry.node ? entry.node->version : entry.image->version;
+        auto type = entry.node ? uint32_t(entry.node->type) : entry.image->valueType;
+        TreeImage::ImageNode imageNode{entry.uuid, entry.parentUuid, version,
+            blobOffset, blobOffset + nameSize, uint32_t(nameSize), uint32_t(dataSize),
+            childIndex, entry.childCount, type, 0};
+        write(&imageNode, sizeof(imageNode));
+        blobOffset += nameSize + dataSize;
+        childIndex += entry.childCount;
+    }
+
+    for (auto& entry : entries)
+    {
+        for (auto c = 0u; c < entry.childCount; c++)
+        {
+            auto index = indices.at(childUuids[entry.childBegin + c]);
+            write(&index, sizeof(index));
+        }
+    }
+
+    for (auto& entry : entries)
+    {
+        auto entryName = name(entry);
+        auto entryData = data(entry);
+        write(entryName.data(), entryName.size());
+        write(entryData.data(), entryData.size());
+    }
+    return image;
+}
+
+bool ProtocolHandler::writeSnapshot(const std::string& pPath)
+{
+    auto tmpPath = pPath + ".tmp";
+    return writeImage(pPath.c_str(), tmpPath.c_str(), buildSnapshot());
+}
+
+void ProtocolHandler::loadSnapshot(const std::string& pPath)
+{
+    LOGLESS_TRACE();
+    auto start = std::chrono::steady_clock::now();
+
+    if (-1 == access(pPath.c_str(), F_OK))
+    {
+        Logless("INF ProtocolHandler: no snapshot to restore.");
+        return;
+    }
+
+    mImage = std::make_unique<TreeImage>(pPath);
+    auto& header = mImage->header();
+    auto imageRoot = mImage->find(ROOT_UUID);
+    if (!imageRoot || !mImage->valid(*imageRoot))
+    {
+        throw std::runtime_error("ProtocolHandler: snapshot without valid root!");
+    }
+
+    auto& root = mTree.at(ROOT_UUID);
+    auto data = mImage->data(*imageRoot);
+    root->version = imageRoot->version;
+    root->data.assign(data, data + imageRoot->dataSize);
+    root->imageChildren = imageRoot->childCount;
+
+    mUuidCtr = header.uuidCtr;
+    mSequence = header.sequence;
+    mSnapshotSequence = header.sequence;
+
+    // Note: Unless mapped, the image is materialized right away and released.
+    if (!mConfig.snapshotMapped)
+    {
+        mTree.reserve(header.nodeCount);
+        traverseTree(*root, true, nullptr, [](Node&, Node&) {
+                return true;
+            });
+        mImage.reset();
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    Logless("INF ProtocolHandler: snapshot restored nodes=_ sequence=_ mapped=_ duration_ms=_",
+        header.nodeCount, header.sequence, mConfig.snapshotMapped, duration.count());
+}
+
+std::shared_ptr<Node> ProtocolHandler::findNode(uint64_t pUuid)
+{
+    auto foundIt = mTree.find(pUuid);
+    if (mTree.end() != foundIt)
+    {
+        return foundIt->second;
+    }
+
+    if (!mImage)
+    {
+        return nullptr;
+    }
+
+    auto imageNode = mImage->find(pUuid);
+    if (!imageNode)
+    {
+        return nullptr;
+    }
+
+    // Note: A node is materialized along with its siblings, a node missing from an already
+    //       materialized parent was deleted.
+    auto parentNode = findNode(imageNode->parentUuid);
+    if (!parentNode || !parentNode->imageChildren)
+    {
+        return nullptr;
+    }
+    loadChildren(*parentNode);
+
+    foundIt = mTree.find(pUuid);
+    return mTree.end() != foundIt ? foundIt->second : nullptr;
+}
+
+void ProtocolHandler::loadChildren(Node& pNode)
+{
+    if (!pNode.imageChildren)
+    {
+        return;
+    }
+    pNode.imageChildren = false;
+
+    auto imageNode = mImage->find(pNode.uuid);
+    auto& parentNode = mTree.at(pNode.uuid);
+    if (!imageNode || !mImage->valid(*imageNode))
+    {
+        Logless("ERR ProtocolHandler: snapshot image node _ is corrupt, children not loaded.", pNode.uuid);
+        return;
+    }
+
+    for (auto i = 0u; i < imageNode->childCount; i++)
+    {
+        auto& imageChild = mImage->child(*imageNode, i);
+        if (!mImage->valid(imageChild) || imageChild.parentUuid != pNode.uuid || mTree.count(imageChild.uuid))
+        {
+            Logless("ERR ProtocolHandler: snapshot image child _ of _ is corrupt, skipped.", imageChild.uuid, pNode.uuid);
+            continue;
+        }
+
+        auto node = std::make_shared<Node>(std::string(mImage->name(imageChild)), NO_SESSION, parentNode, imageChild.uuid);
+        auto data = mImage->data(imageChild);
+        node->version = imageChild.version;
+        node->type = ValueType(imageChild.valueType);
+        node->data.assign(data, data + imageChild.dataSize);
+        node->imageChildren = imageChild.childCount;
+
+        pNode.children.emplace_hint(pNode.children.end(), node->name, node);
+        mTree.emplace(imageChild.uuid, std::move(node));
+    }
+}
+
+void ProtocolHandler::replayJournal(const std::string& pPath)
+{
+    LOGLESS_TRACE();
+    auto start = std::chrono::steady_clock::now();
+    size_t applied = 0;
+
+    Journal::replay(pPath, [this, &applied](const Journal::Record& pRecord, const uint8_t* pData) {
+            // Note: Records already covered by the snapshot are skipped.
+            if (pRecord.sequence <= mSnapshotSequence)
+            {
+                return;
+            }
+            mSequence = pRecord.sequence;
+            applied++;
+
+            if (Journal::RecordType::CREATE == pRecord.type)
+            {
+                auto parentNode = findNode(pRecord.arg);
+                if (!parentNode)
+                {
+                    Logless("WRN ProtocolHandler: journal create of _ without parent _", pRecord.uuid, pRecord.arg);
+                    return;
+                }
+                loadChildren(*parentNode);
+                std::string name((const char*)pData, pRecord.size);
+                auto node = std::make_shared<Node>(name, NO_SESSION, parentNode, pRecord.uuid);
+                node->type = ValueType(pRecord.valueType);
+                parentNode->children.emplace(std::move(name), node);
+                mTree.emplace(pRecord.uuid, std::move(node));
+                mUuidCtr = std::max<uint64_t>(mUuidCtr, pRecord.uuid + 1);
+            }
+            else if (Journal::RecordType::SET == pRecord.type)
+            {
+                auto node = findNode(pRecord.uuid);
+                if (!node)
+                {
+                    return;
+                }
+                node->data.assign(pData, pData + pRecord.size);
+                node->version = pRecord.arg;
+            }
+            else if (Journal::RecordType::DELETE == pRecord.type)
+            {
+                auto node = findNode(pRecord.uuid);
+                if (!node)
+                {
+                    return;
+                }
+                auto parentNode = node->parent.lock();
+                if (!parentNode)
+                {
+                    return;
+                }
+                parentNode->children.erase(node->name);
+                removeSubtree(*parentNode, node);
+            }
+        });
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    Logless("INF ProtocolHandler: journal replayed records=_ sequence=_ duration_ms=_", applied, mSequence, duration.count());
+}
+
+void ProtocolHandler::journal(Journal::RecordType pType, uint64_t pUuid, uint64_t pArg, const void* pData, size_t pSize, ValueType pValueType)
+{
+    if (mJournal)
+    {
+        mJournal->append(pType, mSequence, pUuid, pArg, pData, pSize, uint8_t(pValueType));
+    }
+}
+
+void ProtocolHandler::sendDurable(const PropertyTreeProtocol& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+{
+    if (!mJournal)
+    {
+        send(pMsg, pConnection);
+        return;
+    }
+
+    std::byte buffer[ENCODE_SIZE];
+    auto msgSize = encode(pMsg, buffer, sizeof(buffer));
+    mDurableAcks.emplace_back(DurableAck{mSequence, pConnection, std::vector<std::byte>(buffer, buffer + msgSize)});
+}
+
+void ProtocolHandler::sendDurableAcks()
+{
+    if (!mJournal)
+    {
+        return;
+    }
+
+    // Note: A failed journal never becomes durable again. The mutations are applied already, so the
+    //       held acks go out and the tree is only persisted by snapshots from now on.
+    if (mJournal->failed())
+    {
+        Logless("ERR ProtocolHandler: journal failed, _ held acks released, mutations are no longer journaled!", mDurableAcks.size());
+        mJournal.reset();
+        for (auto& ack : mDurableAcks)
+        {
+            auto connection = ack.connection.lock();
+            send(ack.frame.data(), ack.frame.size(), connection);
+        }
+        mDurableAcks.clear();
+        return;
+    }
+
+    auto durableSequence = mJournal->durableSequence();
+    while (mDurableAcks.size() && mDurableAcks.front().sequence <= durableSequence)
+    {
+        auto& ack = mDurableAcks.front();
+        auto connection = ack.connection.lock();
+        send(ack.frame.data(), ack.frame.size(), connection);
+        mDurableAcks.pop_front();
+    }
+}
+
 size_t ProtocolHandler::encode(const PropertyTreeProtocol& pMsg, std::byte* pData, size_t pSize)
 {
     LOGLESS_TRACE();
@@ -560,7 +2855,7 @@ size_t ProtocolHandler::encode(const PropertyTreeProtocol& pMsg, std::byte* pDat
     return msgSize + 2;
 }
 
-void ProtocolHandler::send(const PropertyTreeProtocol& pMsg, std::shared_ptr<IConnectionSession>& pConnection)
+void ProtocolHandler::send(const PropertyTreeProtocol& pMsg, std::shared_ptr<IConnectionSession>& pConnection, Lane pLane)
 {
     if (!pConnection)
     {
@@ -572,10 +2867,10 @@ void ProtocolHandler::send(const PropertyTreeProtocol& pMsg, std::shared_ptr<ICo
     auto msgSize = encode(pMsg, buffer, sizeof(buffer));
 
     Logless("DBG ProtocolHandler: send: session=_", pConnection.get());
-    pConnection->send(bfc::ConstBufferView(buffer, msgSize));
+    pConnection->send(bfc::ConstBufferView(buffer, msgSize), pLane);
  }
 
-void ProtocolHandler::send(const std::byte* pData, size_t pSize, std::shared_ptr<IConnectionSession>& pConnection)
+void ProtocolHandler::send(const std::byte* pData, size_t pSize, std::shared_ptr<IConnectionSession>& pConnection, Lane pLane)
 {
     if (!pConnection)
     {
@@ -583,7 +2878,7 @@ void ProtocolHandler::send(const std::byte* pData, size_t pSize, std::shared_ptr
     }
     LOGLESS_TRACE();
     Logless("DBG ProtocolHandler: send: session=_", pConnection.get());
-    pConnection->send(bfc::ConstBufferView(pData, pSize));
+    pConnection->send(bfc::ConstBufferView(pData, pSize), pLane);
 }
 
 
@@ -1,6 +1,12 @@
 #ifndef __PROTOCOLHANDLER_HPP__
 #define __PROTOCOLHANDLER_HPP__
 
+#include <sys/types.h>
+
+#include <deque>
+#include <memory>
+#include <random>
+
 #include <bfc/ThreadPool.hpp>
 #include <bfc/Timer.hpp>
 #include <bfc/Singleton.hpp>
@@ -10,11 +16,44 @@
 #include <interface/protocol.hpp>
 
 #include <IConnectionSession.hpp>
+#include <Journal.hpp>
 #include <Node.hpp>
+#include <TimerWheel.hpp>
+#include <TreeImage.hpp>
+#include <ServerConfig.hpp>
 
 namespace propertytree
 {
 
+// DurableAck: response held back until the journal has synced the mutation it acknowledges
+struct DurableAck
+{
+    uint64_t sequence;
+    std::weak_ptr<IConnectionSession> connection;
+    std::vector<std::byte> frame;
+};
+
+// ChangeLogEntry: tree mutation kept so that a resuming session only receives what it missed
+struct ChangeLogEntry
+{
+    enum Type : uint8_t {ADD, DELETE, SET};
+    uint64_t sequence;
+    uint64_t uuid;
+    uint64_t parentUuid;
+    Type type;
+};
+
+// PendingCall: RpcRequest forwarded to its provider and waiting for the response
+struct PendingCall
+{
+    uint32_t sourceSessionId;
+    uint16_t sourceTrId;
+    uint32_t targetSessionId;
+    TimerWheel::Id timer;
+    // credit: RpcPartial frames the caller can still take, zero for calls that don't stream
+    uint32_t credit;
+};
+
 struct Session
 {
     Session() = delete;
@@ -23,15 +62,43 @@ struct Session
     {}
 
     std::shared_ptr<IConnectionSession> connectionSession;
+    uint64_t token = 0;
+    // subscriptions: uuids of the nodes this session listens to, mirrors Node::listener
+    std::unordered_set<uint64_t> subscriptions;
+    // interests: uuids of the nodes whose tree changes this session receives, mirrors Node::treeListener
+    std::unordered_set<uint64_t> interests;
+    std::chrono::steady_clock::time_point disconnectTime;
+
+    // lastActivity: liveness wheel tick of the last message received
+    uint64_t lastActivity = 0;
+    TimerWheel::Id livenessTimer = TimerWheel::INVALID;
+    bool probed = false;
+
+    // incomingCalls: callIds forwarded to this session as provider and not answered yet
+    std::unordered_set<uint64_t> incomingCalls;
+    // outgoingCalls: callIds this session made and still waits for
+    std::unordered_set<uint64_t> outgoingCalls;
+    // providing: uuids of the nodes this session is registered as provider for, mirrors Node::providers
+    std::unordered_set<uint64_t> providing;
+    // ephemerals: uuids of the ephemeral nodes this session created, removed at teardown
+    std::unordered_set<uint64_t> ephemerals;
+
+    // pendingTreeAdd: <Uuid, NamedNode>, uuids are allocated in creation order so parents always come first
+    std::map<uint64_t, NamedNode> pendingTreeAdd;
+    u64Array pendingTreeDelete;
+    size_t pendingTreeUpdateSize = 0;
 };
 
 class ProtocolHandler
 {
 public:
-    ProtocolHandler(bfc::LightFn<void()> pTerminator);
+    ProtocolHandler(bfc::LightFn<void()> pTerminator, const ServerConfig& pConfig);
 
     void onDisconnect(IConnectionSession* pConnection);
     void onMsg(bfc::ConstBufferView pBuffer, std::shared_ptr<IConnectionSession> pConnection);
+    void onTick();
+    // reclaimedSize: estimated heap released by the sessions torn down so far
+    uint64_t reclaimedSize() const;
 
 private:
 
@@ -41,12 +108,22 @@ private:
     template <typename T>
     void handle(uint16_t pTransactionId, T&& pMsg, std::shared_ptr<IConnectionSession>& pConnection) {}
     void handle(uint16_t pTransactionId, SigninRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void handle(uint16_t pTransactionId, ResumeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
     void handle(uint16_t pTransactionId, CreateRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void handle(uint16_t pTransactionId, BulkCreateRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void handle(uint16_t pTransactionId, AggregateCreateRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
     void handle(uint16_t pTransactionId, TreeInfoRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void handle(uint16_t pTransactionId, QueryRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
     void handle(uint16_t pTransactionId, SetValueRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void publishValue(Node& pNode);
+    template <typename T>
+    void updateAggregates(Node& pSource, T&& pAccumulate);
+    void publishAggregate(Node& pNode);
     void handle(uint16_t pTransactionId, GetRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
     void handle(uint16_t pTransactionId, SubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
     void handle(uint16_t pTransactionId, UnsubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void handle(uint16_t pTransactionId, BulkSubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void handle(uint16_t pTransactionId, BulkUnsubscribeRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
     void handle(uint16_t pTransactionId, DeleteRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
 
     template<typename T>
@@ -54,30 +131,101 @@ private:
     void handle(uint16_t pTransactionId, RpcRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
     void handle(uint16_t pTransactionId, RpcAccept&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
     void handle(uint16_t pTransactionId, RpcReject&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void handle(uint16_t pTransactionId, RpcPartial&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void handle(uint16_t pTransactionId, RpcCredit&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void restartCallTimer(PendingCall& pCall, uint64_t pCallId);
+    void handle(uint16_t pTransactionId, ProviderRegisterRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void handle(uint16_t pTransactionId, ProviderUnregisterRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    uint32_t selectProvider(Node& pNode);
+    void removeProvider(Node& pNode, uint32_t pSessionId);
+    void endCall(std::unordered_map<uint64_t, PendingCall>::iterator pCall);
+    void failCall(std::unordered_map<uint64_t, PendingCall>::iterator pCall, Cause pCause);
+    void expireCall(uint64_t pCallId);
 
     void handle(uint16_t pTransactionId, HearbeatRequest&& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
 
+    // Note: pVisitor sees each node with mTraversalStack holding its ancestry, pMaxDepth bounds a recursive walk.
     template <typename T>
-    void fillToAddListFromTree(T& pIe, std::shared_ptr<Node>& pNode, bool pRecursive);
+    uint64_t traverseTree(Node& pNode, bool pRecursive, Node* pFrom, T&& pVisitor, size_t pMaxDepth = SIZE_MAX);
+    size_t encodeTreeInfoResponse(uint16_t pTransactionId, Node* pNamedParent, Node& pNode, bool pRecursive, bool pWithValue,
+        uint32_t pSessionId, Node* pFrom, std::byte* pData, size_t pSize);
+    void queueTreeAdd(const std::unordered_set<uint32_t>& pSessionIds, const NamedNode& pNode, uint32_t pExcludedSessionId);
+    void queueTreeDelete(Node& pParent, Node& pNode);
+    void queueTreeDelete(uint32_t pSessionId, uint64_t pUuid);
+    void removeSubtree(Node& pParent, std::shared_ptr<Node> pNode);
+    // Note: A partial flush happens in the middle of a change, its sequence is the last complete one.
+    void flushTreeUpdate(uint32_t pSessionId, bool pPartial = false);
+    void addTreeListener(Node& pNode, uint32_t pSessionId);
+    void expireSessions();
+    void teardownSession(uint32_t pSessionId);
+    uint64_t toTicks(std::chrono::milliseconds pDuration) const;
+    void armLiveness(Session& pSession, uint32_t pSessionId);
+    void disarmLiveness(Session& pSession);
+    void checkLiveness(uint32_t pSessionId);
+    void logChange(ChangeLogEntry::Type pType, uint64_t pUuid, uint64_t pParentUuid);
+    void resync(uint32_t pSessionId, uint64_t pSequence);
+
+    void checkSnapshot();
+    void startSnapshot();
+    std::vector<std::byte> buildSnapshot();
+    bool writeSnapshot(const std::string& pPath);
+    void loadSnapshot(const std::string& pPath);
+    std::shared_ptr<Node> findNode(uint64_t pUuid);
+    void loadChildren(Node& pNode);
+    void replayJournal(const std::string& pPath);
+    void journal(Journal::RecordType pType, uint64_t pUuid, uint64_t pArg, const void* pData, size_t pSize, ValueType pValueType = ValueType::NONE);
+    void sendDurable(const PropertyTreeProtocol& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
+    void sendDurableAcks();
 
     size_t encode(const PropertyTreeProtocol& pMsg, std::byte* pData, size_t pSize);
-    void send(const PropertyTreeProtocol& pMsg, std::shared_ptr<IConnectionSession>& pConnection);
-    void send(const std::byte* pData, size_t pSize, std::shared_ptr<IConnectionSession>& pConnection);
+    void send(const PropertyTreeProtocol& pMsg, std::shared_ptr<IConnectionSession>& pConnection, Lane pLane = Lane::RESPONSE);
+    void send(const std::byte* pData, size_t pSize, std::shared_ptr<IConnectionSession>& pConnection, Lane pLane = Lane::RESPONSE);
 
 
     // mSessions: <SessionId, Session>
     std::unordered_map<uint32_t, std::shared_ptr<Session>> mSessions;
     std::unordered_map<IConnectionSession*, uint32_t> mConnectionToSessionId;
     uint32_t mSessionIdCtr{};
-
-    uint32_t mTrIdCtr{};
-    // mTrIdTranslation: TrId Req - Resp Translation Table: map<DestinationTrId, <SourceSessionId, SourceTrId>>
-    std::unordered_map<uint16_t, std::pair<uint32_t, uint16_t>> mTrIdTranslation;
+    // mSessionTokens: <Token, SessionId>
+    std::unordered_map<uint64_t, uint32_t> mSessionTokens;
+    std::mt19937_64 mTokenGenerator{std::random_device{}()};
+    // mDisconnectedSessions: <DisconnectTime, SessionId> in disconnection order, torn down after the grace period
+    std::deque<std::pair<std::chrono::steady_clock::time_point, uint32_t>> mDisconnectedSessions;
+    uint64_t mReclaimedSize{};
+    // mLivenessWheel: one timer per connected session, advanced on every tick
+    TimerWheel mLivenessWheel;
+    // mChangeLog: recent mutations in sequence order, those up to mChangeLogFloor were dropped
+    std::deque<ChangeLogEntry> mChangeLog;
+    uint64_t mChangeLogFloor{};
+    static constexpr uint32_t NO_SESSION = 0xFFFFFFFF;
+    // mTreeUpdatePending: sessions with queued TreeUpdateNotification entries
+    std::unordered_set<uint32_t> mTreeUpdatePending;
+
+    uint64_t mCallIdCtr{};
+    // mPendingCalls: <CallId, PendingCall>
+    std::unordered_map<uint64_t, PendingCall> mPendingCalls;
+    // mRpcWheel: call deadlines, advanced on every tick
+    TimerWheel mRpcWheel;
 
     std::unordered_map<uint64_t, std::shared_ptr<Node>> mTree;
     uint32_t mUuidCtr{};
+    // mTraversalStack: <Parent, Next child>, kept between traversals so that walking the tree doesn't allocate
+    std::vector<std::pair<Node*, std::map<std::string, std::shared_ptr<Node>>::iterator>> mTraversalStack;
+
+    // mSequence: incremented on every mutation of the tree
+    uint64_t mSequence{};
+    // mSnapshotSequence: mSequence covered by the last snapshot written
+    uint64_t mSnapshotSequence{};
+    uint64_t mSnapshotPendingSequence{};
+    pid_t mSnapshotPid = -1;
+    std::chrono::steady_clock::time_point mSnapshotTime;
+    std::unique_ptr<Journal> mJournal;
+    // mImage: mapped snapshot the nodes not yet in mTree are materialized from, null when not mapped
+    std::unique_ptr<TreeImage> mImage;
+    std::deque<DurableAck> mDurableAcks;
 
     bfc::LightFn<void()> mTerminator;
+    ServerConfig mConfig;
 
 };
 
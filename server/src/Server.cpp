@@ -1,14 +1,16 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <sys/timerfd.h>
+#include <sys/epoll.h>
 
 #include <Server.hpp>
 
 namespace propertytree
 {
 
-Server::Server()
-    : mProto([this](){mReactor.stop();})
+Server::Server(const ServerConfig& pConfig)
+    : mProto([this](){mReactor.stop();}, pConfig)
 {
     mServerFd = socket(AF_INET, SOCK_STREAM, 0);
     if (-1 == mServerFd)
@@ -23,7 +25,7 @@ Server::Server()
         throw std::runtime_error(strerror(errno));
     }
 
-    uint16_t port = 12345;
+    uint16_t port = pConfig.port;
     sockaddr_in addr;
     std::memset(&addr, 0, sizeof(addr));
     addr.sin_family = AF_INET;
@@ -54,6 +56,45 @@ Server::Server()
     {
         throw std::runtime_error("Server: Failed to register server to EpollReactor.");
     }
+
+    mTickFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if (-1 == mTickFd)
+    {
+        throw std::runtime_error(strerror(errno));
+    }
+
+    auto tickPeriod = std::chrono::duration_cast<std::chrono::nanoseconds>(pConfig.tickPeriod).count();
+    itimerspec period{};
+    period.it_interval.tv_sec = tickPeriod / 1000000000;
+    period.it_interval.tv_nsec = tickPeriod % 1000000000;
+    period.it_value = period.it_interval;
+    res = timerfd_settime(mTickFd, 0, &period, nullptr);
+
+    if (-1 == res)
+    {
+        throw std::runtime_error(strerror(errno));
+    }
+
+    if (!mReactor.addHandler(mTickFd, [this](){
+            handleTick();
+        }))
+    {
+        throw std::runtime_error("Server: Failed to register tick timer to EpollReactor.");
+    }
+
+    // Note: The reactor only watches reads, writability is watched through a nested epoll set.
+    mWritableFd = epoll_create1(0);
+    if (-1 == mWritableFd)
+    {
+        throw std::runtime_error(strerror(errno));
+    }
+
+    if (!mReactor.addHandler(mWritableFd, [this](){
+            handleWritable();
+        }))
+    {
+        throw std::runtime_error("Server: Failed to register writable set to EpollReactor.");
+    }
 }
 
 void Server::run()
@@ -65,11 +106,75 @@ void Server::onDisconnect(int pFd)
 {
     Logless("Server: client disconnected fd=_", pFd);
     mReactor.removeHandler(pFd);
+    epoll_ctl(mWritableFd, EPOLL_CTL_DEL, pFd, nullptr);
     auto connectionRaw = mConnections.find(pFd)->second.get();
     mConnections.erase(pFd);
     mProto.onDisconnect(connectionRaw);
 }
 
+void Server::handleTick()
+{
+    uint64_t expirations;
+    if (-1 == read(mTickFd, &expirations, sizeof(expirations)))
+    {
+        return;
+    }
+
+    mProto.onTick();
+
+    for (auto& i : mConnections)
+    {
+        i.second->flush();
+    }
+
+    disconnectBroken();
+}
+
+void Server::onBlocked(int pFd)
+{
+    epoll_event event{};
+    event.events = EPOLLOUT | EPOLLONESHOT;
+    event.data.fd = pFd;
+    if (-1 == epoll_ctl(mWritableFd, EPOLL_CTL_MOD, pFd, &event) && ENOENT == errno)
+    {
+        epoll_ctl(mWritableFd, EPOLL_CTL_ADD, pFd, &event);
+    }
+}
+
+void Server::handleWritable()
+{
+    epoll_event events[64];
+    auto n = epoll_wait(mWritableFd, events, 64, 0);
+
+    for (int i = 0; i < n; i++)
+    {
+        auto connection = mConnections.find(events[i].data.fd);
+        if (mConnections.end() != connection)
+        {
+            connection->second->flush();
+        }
+    }
+
+    disconnectBroken();
+}
+
+void Server::disconnectBroken()
+{
+    std::vector<int> broken;
+    for (auto& i : mConnections)
+    {
+        if (i.second->broken())
+        {
+            broken.emplace_back(i.first);
+        }
+    }
+
+    for (auto fd : broken)
+    {
+        onDisconnect(fd);
+    }
+}
+
 void Server::handleServerRead()
 {
     sockaddr_in addr;
@@ -10,6 +10,7 @@
 #include <IServer.hpp>
 #include <ConnectionSession.hpp>
 #include <ProtocolHandler.hpp>
+#include <ServerConfig.hpp>
 
 namespace propertytree
 {
@@ -17,16 +18,23 @@ namespace propertytree
 class Server : public IServer
 {
 public:
-    Server();
+    Server(const ServerConfig& pConfig);
     void run();
 
 private:
 
     void onDisconnect(int pFd);
+    void onBlocked(int pFd);
     void handleServerRead();
+    void handleTick();
+    void handleWritable();
+    void disconnectBroken();
 
     bfc::EpollReactor mReactor;
     int mServerFd;
+    int mTickFd;
+    // mWritableFd: epoll set of the blocked connections, readable when one of them can be written
+    int mWritableFd;
 
     std::map<int, std::shared_ptr<ConnectionSession>> mConnections;
     std::mutex mConnectionsMutex;
@@ -0,0 +1,40 @@
+#ifndef __SERVERCONFIG_HPP__
+#define __SERVERCONFIG_HPP__
+
+#include <chrono>
+#include <string>
+
+namespace propertytree
+{
+
+struct ServerConfig
+{
+    uint16_t port = 12345;
+    // snapshotPath: file the tree is persisted to and restored from, empty disables persistence
+    std::string snapshotPath;
+    std::chrono::seconds snapshotPeriod{60};
+    // snapshotMapped: serve the snapshot from a memory mapping and materialize nodes on first access
+    bool snapshotMapped = false;
+    // journalPath: mutation journal replayed on top of the snapshot, empty disables it
+    std::string journalPath;
+    // Note: The journal is synced when either threshold is reached, mutations are acknowledged after that.
+    std::chrono::milliseconds journalSyncPeriod{10};
+    size_t journalSyncSize = 1024*1024;
+    // changeLogSize: mutations kept for resuming sessions, older ones force a full resync
+    size_t changeLogSize = 1024*64;
+    // sessionGracePeriod: how long a disconnected session can be resumed before it is torn down
+    std::chrono::seconds sessionGracePeriod{30};
+    std::chrono::milliseconds tickPeriod{10};
+    // idleTimeout: connections silent for longer are closed, zero disables it
+    std::chrono::milliseconds idleTimeout{0};
+    // probePeriod: silence after which a HearbeatRequest is sent to the client, zero disables probes
+    std::chrono::milliseconds probePeriod{0};
+    // rpcTimeout: calls unanswered for longer are rejected with TIMEOUT, below the client's own timeout
+    std::chrono::milliseconds rpcTimeout{400};
+    // rpcInFlightLimit: unanswered calls a provider can have before new ones are rejected with BUSY
+    uint32_t rpcInFlightLimit = 1024;
+};
+
+} // propertytree
+
+#endif // __SERVERCONFIG_HPP__
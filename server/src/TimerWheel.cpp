@@ -0,0 +1,85 @@
+#include <algorithm>
+
+#include <TimerWheel.hpp>
+
+namespace propertytree
+{
+
+TimerWheel::TimerWheel()
+{
+    std::fill(std::begin(mSlots), std::end(mSlots), INVALID);
+}
+
+TimerWheel::Id TimerWheel::schedule(uint64_t pDelay, uint64_t pCookie)
+{
+    Id id;
+    if (mFree.size())
+    {
+        id = mFree.back();
+        mFree.pop_back();
+    }
+    else
+    {
+        id = mEntries.size();
+        mEntries.emplace_back();
+    }
+
+    auto maxDelay = (uint64_t(1) << (LEVELS*LEVEL_BITS)) - 1;
+    auto& entry = mEntries[id];
+    entry.expiry = mNow + std::clamp<uint64_t>(pDelay, 1, maxDelay);
+    entry.cookie = pCookie;
+    link(id);
+    return id;
+}
+
+void TimerWheel::cancel(Id pId)
+{
+    unlink(pId);
+    mFree.emplace_back(pId);
+}
+
+uint64_t TimerWheel::now() const
+{
+    return mNow;
+}
+
+void TimerWheel::link(Id pId)
+{
+    auto& entry = mEntries[pId];
+    auto delta = entry.expiry > mNow ? entry.expiry - mNow : 0;
+
+    unsigned level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t(1) << ((level + 1)*LEVEL_BITS)))
+    {
+        level++;
+    }
+
+    entry.slot = level*SLOTS + ((entry.expiry >> (level*LEVEL_BITS)) & (SLOTS - 1));
+    entry.prev = INVALID;
+    entry.next = mSlots[entry.slot];
+    if (INVALID != entry.next)
+    {
+        mEntries[entry.next].prev = pId;
+    }
+    mSlots[entry.slot] = pId;
+}
+
+void TimerWheel::unlink(Id pId)
+{
+    auto& entry = mEntries[pId];
+    if (INVALID != entry.prev)
+    {
+        mEntries[entry.prev].next = entry.next;
+    }
+    else
+    {
+        mSlots[entry.slot] = entry.next;
+    }
+
+    if (INVALID != entry.next)
+    {
+        mEntries[entry.next].prev = entry.prev;
+    }
+}
+
+} // propertytree
@@ -0,0 +1,84 @@
+#ifndef __TIMERWHEEL_HPP__
+#define __TIMERWHEEL_HPP__
+
+#include <cstdint>
+#include <vector>
+
+namespace propertytree
+{
+
+// TimerWheel: hierarchical timing wheel advanced one tick at a time by its owner, schedule, cancel
+//             and expiry are O(1), a timer is moved down at most once per level
+class TimerWheel
+{
+public:
+    using Id = uint32_t;
+    static constexpr Id INVALID = 0xFFFFFFFF;
+
+    TimerWheel();
+
+    // Note: pDelay is in ticks, delays beyond the last level are clamped to it.
+    Id schedule(uint64_t pDelay, uint64_t pCookie);
+    void cancel(Id pId);
+    uint64_t now() const;
+
+    // Note: pExpired(cookie) is called for every timer due, it may schedule and cancel timers.
+    template <typename T>
+    void advance(T&& pExpired)
+    {
+        mNow++;
+
+        // Note: Higher levels first so that their timers can still fall through to level 0.
+        for (unsigned level = LEVELS - 1; level > 0; level--)
+        {
+            if (mNow & ((uint64_t(1) << (level*LEVEL_BITS)) - 1))
+            {
+                continue;
+            }
+            auto slot = level*SLOTS + ((mNow >> (level*LEVEL_BITS)) & (SLOTS - 1));
+            while (INVALID != mSlots[slot])
+            {
+                auto id = mSlots[slot];
+                unlink(id);
+                link(id);
+            }
+        }
+
+        auto slot = mNow & (SLOTS - 1);
+        while (INVALID != mSlots[slot])
+        {
+            auto id = mSlots[slot];
+            auto cookie = mEntries[id].cookie;
+            unlink(id);
+            mFree.emplace_back(id);
+            pExpired(cookie);
+        }
+    }
+
+private:
+    static constexpr unsigned LEVEL_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << LEVEL_BITS;
+    static constexpr unsigned LEVELS = 4;
+
+    struct Entry
+    {
+        uint64_t expiry;
+        uint64_t cookie;
+        Id prev;
+        Id next;
+        uint32_t slot;
+    };
+
+    void link(Id pId);
+    void unlink(Id pId);
+
+    // mEntries: timer storage indexed by Id, slots are intrusive lists through prev and next
+    std::vector<Entry> mEntries;
+    std::vector<Id> mFree;
+    Id mSlots[LEVELS*SLOTS];
+    uint64_t mNow = 0;
+};
+
+} // propertytree
+
+#endif // __TIMERWHEEL_HPP__
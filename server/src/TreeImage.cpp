@@ -0,0 +1,123 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <TreeImage.hpp>
+
+namespace propertytree
+{
+
+TreeImage::TreeImage(const std::string& pPath)
+{
+    int fd = open(pPath.c_str(), O_RDONLY);
+    if (-1 == fd)
+    {
+        throw std::runtime_error(strerror(errno));
+    }
+
+    struct stat fileStat;
+    if (-1 == fstat(fd, &fileStat))
+    {
+        close(fd);
+        throw std::runtime_error(strerror(errno));
+    }
+    mSize = fileStat.st_size;
+
+    if (mSize < sizeof(ImageHeader))
+    {
+        close(fd);
+        throw std::runtime_error("TreeImage: image is truncated!");
+    }
+
+    auto base = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base)
+    {
+        throw std::runtime_error(strerror(errno));
+    }
+    mBase = (const uint8_t*)base;
+
+    // Note: Access is driven by lookups, read-ahead would only pull in cold nodes.
+    madvise(base, mSize, MADV_RANDOM);
+
+    mHeader = (const ImageHeader*)mBase;
+    mNodes = (const ImageNode*)(mBase + mHeader->nodesOffset);
+    mChildren = (const uint32_t*)(mBase + mHeader->childrenOffset);
+
+    // Note: Sizes are compared by division so that a corrupted count can't wrap around.
+    if (MAGIC != mHeader->magic ||
+        mHeader->nodesOffset > mSize || mHeader->nodesOffset % alignof(ImageNode) ||
+        mHeader->nodeCount > (mSize - mHeader->nodesOffset)/sizeof(ImageNode) ||
+        mHeader->childrenOffset > mSize || mHeader->childrenOffset % alignof(uint32_t) ||
+        mHeader->childrenCount > (mSize - mHeader->childrenOffset)/sizeof(uint32_t) ||
+        mHeader->blobOffset > mSize)
+    {
+        munmap(base, mSize);
+        throw std::runtime_error("TreeImage: invalid image!");
+    }
+}
+
+TreeImage::~TreeImage()
+{
+    munmap((void*)mBase, mSize);
+}
+
+const TreeImage::ImageHeader& TreeImage::header() const
+{
+    return *mHeader;
+}
+
+const TreeImage::ImageNode* TreeImage::find(uint64_t pUuid) const
+{
+    auto end = mNodes + mHeader->nodeCount;
+    auto foundIt = std::lower_bound(mNodes, end, pUuid, [](const ImageNode& pNode, uint64_t pUuid) {
+            return pNode.uuid < pUuid;
+        });
+    if (end == foundIt || pUuid != foundIt->uuid)
+    {
+        return nullptr;
+    }
+    return foundIt;
+}
+
+bool TreeImage::valid(const ImageNode& pNode) const
+{
+    auto blobSize = mSize - mHeader->blobOffset;
+    if (pNode.nameOffset > blobSize || pNode.nameSize > blobSize - pNode.nameOffset ||
+        pNode.dataOffset > blobSize || pNode.dataSize > blobSize - pNode.dataOffset ||
+        pNode.childIndex > mHeader->childrenCount || pNode.childCount > mHeader->childrenCount - pNode.childIndex)
+    {
+        return false;
+    }
+
+    for (auto i = 0u; i < pNode.childCount; i++)
+    {
+        if (mChildren[pNode.childIndex + i] >= mHeader->nodeCount)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const TreeImage::ImageNode& TreeImage::child(const ImageNode& pNode, uint32_t pIndex) const
+{
+    return mNodes[mChildren[pNode.childIndex + pIndex]];
+}
+
+std::string_view TreeImage::name(const ImageNode& pNode) const
+{
+    return std::string_view((const char*)mBase + mHeader->blobOffset + pNode.nameOffset, pNode.nameSize);
+}
+
+const uint8_t* TreeImage::data(const ImageNode& pNode) const
+{
+    return mBase + mHeader->blobOffset + pNode.dataOffset;
+}
+
+} // propertytree
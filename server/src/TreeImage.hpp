@@ -0,0 +1,70 @@
+#ifndef __TREEIMAGE_HPP__
+#define __TREEIMAGE_HPP__
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace propertytree
+{
+
+// TreeImage: read-only, memory-mapped and pointer-free tree as written by a snapshot
+// Note: File layout, host byte order:
+//       ImageHeader, ImageNode[nodeCount] sorted by uuid, uint32_t children[] indexing the node table
+//       with siblings contiguous and sorted by name, then the names and values blob.
+class TreeImage
+{
+public:
+    static constexpr uint64_t MAGIC = 0x3330504E53545450; // "PTTSNP03"
+
+    struct ImageHeader
+    {
+        uint64_t magic;
+        uint64_t sequence;
+        uint64_t uuidCtr;
+        uint64_t nodeCount;
+        uint64_t childrenCount;
+        uint64_t nodesOffset;
+        uint64_t childrenOffset;
+        uint64_t blobOffset;
+    };
+
+    struct ImageNode
+    {
+        uint64_t uuid;
+        uint64_t parentUuid;
+        uint64_t version;
+        uint64_t nameOffset;
+        uint64_t dataOffset;
+        uint32_t nameSize;
+        uint32_t dataSize;
+        uint32_t childIndex;
+        uint32_t childCount;
+        uint32_t valueType;
+        uint32_t reserved;
+    };
+
+    TreeImage(const std::string& pPath);
+    ~TreeImage();
+    TreeImage(const TreeImage&) = delete;
+    TreeImage& operator=(const TreeImage&) = delete;
+
+    const ImageHeader& header() const;
+    const ImageNode* find(uint64_t pUuid) const;
+    // valid: the name, data and children of pNode lie within the image, to be checked before they are accessed
+    bool valid(const ImageNode& pNode) const;
+    const ImageNode& child(const ImageNode& pNode, uint32_t pIndex) const;
+    std::string_view name(const ImageNode& pNode) const;
+    const uint8_t* data(const ImageNode& pNode) const;
+
+private:
+    const uint8_t* mBase = nullptr;
+    size_t mSize = 0;
+    const ImageHeader* mHeader;
+    const ImageNode* mNodes;
+    const uint32_t* mChildren;
+};
+
+} // propertytree
+
+#endif // __TREEIMAGE_HPP__
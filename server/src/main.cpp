@@ -1,5 +1,10 @@
 #include <signal.h>
 
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
 #include <Server.hpp>
 
 #include <bfc/Singleton.hpp>
@@ -8,11 +13,119 @@
 
 using namespace propertytree;
 
-int main()
+static void usage(const char* pName)
+{
+    std::cerr << "usage: " << pName << " [key=value]...\n"
+        "    port=<number>\n"
+        "    snapshot=<path>\n"
+        "    snapshot_period=<seconds>\n"
+        "    snapshot_mapped=<0|1>\n"
+        "    journal=<path>\n"
+        "    journal_sync_ms=<milliseconds>\n"
+        "    journal_sync_size=<bytes>\n"
+        "    change_log_size=<entries>\n"
+        "    session_grace_period=<seconds>\n"
+        "    idle_timeout_ms=<milliseconds>\n"
+        "    probe_period_ms=<milliseconds>\n"
+        "    rpc_timeout_ms=<milliseconds>\n"
+        "    rpc_in_flight_limit=<calls>\n";
+}
+
+int main(int argc, const char* argv[])
 {
     signal(SIGPIPE, SIG_IGN);
     Logger::getInstance().logful();
 
+    // Note: Arguments are given as key=value, e.g. snapshot=/var/lib/propertytree.snapshot
+    ServerConfig config;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        auto separator = arg.find('=');
+        auto key = arg.substr(0, separator);
+        auto value = std::string::npos == separator ? std::string() : arg.substr(separator + 1);
+
+        // Note: Numbers that don't parse or don't fit are rejected instead of ending the server with an exception.
+        try
+        {
+            if ("port" == key)
+            {
+                auto port = std::stoul(value);
+                if (port > UINT16_MAX)
+                {
+                    throw std::out_of_range("port");
+                }
+                config.port = port;
+            }
+            else if ("snapshot" == key)
+            {
+                config.snapshotPath = value;
+            }
+            else if ("snapshot_period" == key)
+            {
+                config.snapshotPeriod = std::chrono::seconds(std::stoul(value));
+            }
+            else if ("snapshot_mapped" == key)
+            {
+                config.snapshotMapped = "1" == value || "true" == value;
+            }
+            else if ("journal" == key)
+            {
+                config.journalPath = value;
+            }
+            else if ("journal_sync_ms" == key)
+            {
+                config.journalSyncPeriod = std::chrono::milliseconds(std::stoul(value));
+            }
+            else if ("journal_sync_size" == key)
+            {
+                config.journalSyncSize = std::stoul(value);
+            }
+            else if ("change_log_size" == key)
+            {
+                config.changeLogSize = std::stoul(value);
+            }
+            else if ("session_grace_period" == key)
+            {
+                config.sessionGracePeriod = std::chrono::seconds(std::stoul(value));
+            }
+            else if ("idle_timeout_ms" == key)
+            {
+                config.idleTimeout = std::chrono::milliseconds(std::stoul(value));
+            }
+            else if ("probe_period_ms" == key)
+            {
+                config.probePeriod = std::chrono::milliseconds(std::stoul(value));
+            }
+            else if ("rpc_timeout_ms" == key)
+            {
+                config.rpcTimeout = std::chrono::milliseconds(std::stoul(value));
+            }
+            else if ("rpc_in_flight_limit" == key)
+            {
+                config.rpcInFlightLimit = std::stoul(value);
+            }
+            else
+            {
+                Logless("ERR main: unknown argument _", argv[i]);
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        catch (const std::invalid_argument&)
+        {
+            Logless("ERR main: invalid number in _", argv[i]);
+            usage(argv[0]);
+            return 1;
+        }
+        catch (const std::out_of_range&)
+        {
+            Logless("ERR main: number out of range in _", argv[i]);
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
     bfc::Singleton<bfc::ThreadPool<>>::instantiate();
     auto& timer = bfc::Singleton<bfc::Timer<>>::instantiate();
 
@@ -20,7 +133,7 @@ int main()
         timer.run();
     });
 
-    Server server;
+    Server server(config);
     server.run();
 
     timer.stop();
@@ -0,0 +1,139 @@
+#include <signal.h>
+#include <algorithm>
+#include <sys/socket.h>
+
+#include <gtest/gtest.h>
+
+#include <ConnectionSession.hpp>
+
+using namespace testing;
+using namespace propertytree;
+
+struct ServerMock : IServer
+{
+    void onDisconnect(int pFd) override
+    {
+        disconnected.emplace_back(pFd);
+    }
+
+    void onBlocked(int pFd) override
+    {
+        blocked.emplace_back(pFd);
+    }
+
+    std::vector<int> disconnected;
+    std::vector<int> blocked;
+};
+
+struct ConnectionSessionTest : Test
+{
+    ConnectionSessionTest()
+        : proto([](){}, ServerConfig{})
+    {
+        signal(SIGPIPE, SIG_IGN);
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        int sendBuffer = 4096;
+        setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+        sut = std::make_shared<ConnectionSession>(fds[0], server, proto);
+    }
+
+    ~ConnectionSessionTest()
+    {
+        sut.reset();
+        if (-1 != fds[1])
+        {
+            close(fds[1]);
+        }
+    }
+
+    // send: sends a frame of pSize bytes filled with pMarker after its uint16_t size
+    void send(char pMarker, uint16_t pSize, Lane pLane)
+    {
+        std::vector<std::byte> frame(pSize, std::byte(pMarker));
+        std::memcpy(frame.data(), &pSize, sizeof(pSize));
+        IConnectionSession& session = *sut;
+        session.send(bfc::ConstBufferView(frame.data(), frame.size()), pLane);
+    }
+
+    // receive: drains the peer while flushing the session, returns the frame markers in arrival order
+    std::string receive()
+    {
+        std::string markers;
+        std::vector<std::byte> stream;
+        std::byte buffer[4096];
+        while (true)
+        {
+            sut->flush();
+            auto res = recv(fds[1], buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (0 >= res)
+            {
+                break;
+            }
+            stream.insert(stream.end(), buffer, buffer + res);
+        }
+
+        size_t offset = 0;
+        while (offset + sizeof(uint16_t) < stream.size())
+        {
+            uint16_t size;
+            std::memcpy(&size, stream.data() + offset, sizeof(size));
+            markers.push_back(char(stream[offset + sizeof(size)]));
+            offset += size;
+        }
+        EXPECT_EQ(stream.size(), offset);
+        return markers;
+    }
+
+    int fds[2] = {-1, -1};
+    ServerMock server;
+    ProtocolHandler proto;
+    std::shared_ptr<ConnectionSession> sut;
+};
+
+TEST_F(ConnectionSessionTest, shouldSendControlAheadOfQueuedBulk)
+{
+    while (server.blocked.empty())
+    {
+        send('b', 1000, Lane::BULK);
+    }
+    for (int i = 0; i < 20; i++)
+    {
+        send('b', 1000, Lane::BULK);
+    }
+    send('c', 100, Lane::CONTROL);
+
+    auto markers = receive();
+    auto control = markers.find('c');
+    ASSERT_NE(std::string::npos, control);
+    EXPECT_EQ(std::string::npos, markers.find('c', control + 1));
+    // Note: Only the frame that was already on the wire may finish before the control frame.
+    EXPECT_LE(20u, markers.size() - control - 1);
+    EXPECT_FALSE(sut->broken());
+}
+
+TEST_F(ConnectionSessionTest, shouldBreakWhenBulkLaneOverflows)
+{
+    for (int i = 0; i < 1024 && !sut->broken(); i++)
+    {
+        send('b', 60000, Lane::BULK);
+    }
+    EXPECT_TRUE(sut->broken());
+
+    // Note: A broken session drops what is sent to it until the server disconnects it.
+    send('c', 100, Lane::CONTROL);
+    std::byte buffer[4096];
+    ssize_t res;
+    while (0 < (res = recv(fds[1], buffer, sizeof(buffer), MSG_DONTWAIT)))
+    {
+        sut->flush();
+        EXPECT_EQ(buffer + res, std::find(buffer, buffer + res, std::byte('c')));
+    }
+}
+
+TEST_F(ConnectionSessionTest, shouldBreakOnWriteError)
+{
+    close(fds[1]);
+    fds[1] = -1;
+    send('r', 100, Lane::RESPONSE);
+    EXPECT_TRUE(sut->broken());
+}
@@ -0,0 +1,178 @@
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <Journal.hpp>
+
+using namespace testing;
+using namespace propertytree;
+
+struct JournalTest : Test
+{
+    JournalTest()
+        : path(std::string("/tmp/JournalTest.") + std::to_string(getpid()))
+    {
+        unlink(path.c_str());
+        unlink((path + ".old").c_str());
+    }
+
+    ~JournalTest()
+    {
+        sut.reset();
+        unlink(path.c_str());
+        unlink((path + ".old").c_str());
+    }
+
+    void start(std::chrono::milliseconds pSyncPeriod, size_t pSyncSize)
+    {
+        sut = std::make_unique<Journal>(path, pSyncPeriod, pSyncSize);
+    }
+
+    void append(uint64_t pSequence)
+    {
+        sut->append(Journal::RecordType::SET, pSequence, 1, pSequence, "data", 4);
+    }
+
+    bool waitDurable(uint64_t pSequence)
+    {
+        for (int i = 0; i < 5000 && sut->durableSequence() != pSequence; i++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return sut->durableSequence() == pSequence;
+    }
+
+    std::vector<uint64_t> replay()
+    {
+        std::vector<uint64_t> rv;
+        Journal::replay(path, [&rv](const Journal::Record& pRecord, const uint8_t* pData) {
+                EXPECT_EQ(4u, pRecord.size);
+                EXPECT_EQ(0, std::memcmp("data", pData, 4));
+                rv.emplace_back(pRecord.sequence);
+            });
+        return rv;
+    }
+
+    size_t fileSize()
+    {
+        struct stat fileStat{};
+        stat(path.c_str(), &fileStat);
+        return fileStat.st_size;
+    }
+
+    static constexpr size_t RECORD_SIZE = sizeof(Journal::Record) + 4;
+    std::string path;
+    std::unique_ptr<Journal> sut;
+};
+
+TEST_F(JournalTest, shouldCommitInGroupsOfSyncSize)
+{
+    start(std::chrono::hours(1), 3*RECORD_SIZE);
+    append(1);
+    append(2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(0u, sut->durableSequence());
+    EXPECT_EQ(0u, fileSize());
+
+    append(3);
+    EXPECT_TRUE(waitDurable(3));
+    EXPECT_EQ(3*RECORD_SIZE, fileSize());
+
+    // Note: The rest is written on destruction.
+    append(4);
+    sut.reset();
+    EXPECT_EQ((std::vector<uint64_t>{1, 2, 3, 4}), replay());
+}
+
+TEST_F(JournalTest, shouldReplayRotatedFileFirstAndRelease)
+{
+    start(std::chrono::milliseconds(1), 1024*1024);
+    append(1);
+    append(2);
+    sut->rotate();
+    append(3);
+    EXPECT_TRUE(waitDurable(3));
+    EXPECT_EQ(0, access((path + ".old").c_str(), F_OK));
+    sut.reset();
+    EXPECT_EQ((std::vector<uint64_t>{1, 2, 3}), replay());
+
+    start(std::chrono::milliseconds(1), 1024*1024);
+    sut->release();
+    append(4);
+    EXPECT_TRUE(waitDurable(4));
+    EXPECT_EQ(-1, access((path + ".old").c_str(), F_OK));
+    sut.reset();
+    EXPECT_EQ((std::vector<uint64_t>{3, 4}), replay());
+}
+
+TEST_F(JournalTest, shouldCutTornTailOnReplay)
+{
+    start(std::chrono::milliseconds(1), 1024*1024);
+    append(1);
+    append(2);
+    sut.reset();
+    auto size = fileSize();
+
+    // Note: A record header claiming more data than was written before a crash.
+    Journal::Record torn{3, 1, 3, 100, Journal::RecordType::SET, 0, {}};
+    auto file = fopen(path.c_str(), "a");
+    fwrite(&torn, sizeof(torn), 1, file);
+    fwrite("data", 4, 1, file);
+    fclose(file);
+
+    EXPECT_EQ((std::vector<uint64_t>{1, 2}), replay());
+    EXPECT_EQ(size, fileSize());
+
+    start(std::chrono::milliseconds(1), 1024*1024);
+    append(3);
+    sut.reset();
+    EXPECT_EQ((std::vector<uint64_t>{1, 2, 3}), replay());
+}
+
+TEST_F(JournalTest, shouldRetryFailedBatchBeforeAdvancing)
+{
+    signal(SIGXFSZ, SIG_IGN);
+    rlimit original;
+    getrlimit(RLIMIT_FSIZE, &original);
+
+    start(std::chrono::milliseconds(1), 1024*1024);
+    append(1);
+    ASSERT_TRUE(waitDurable(1));
+
+    // Note: The file size limit lets only part of the next batch through.
+    rlimit limited = original;
+    limited.rlim_cur = fileSize() + RECORD_SIZE/2;
+    setrlimit(RLIMIT_FSIZE, &limited);
+    append(2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    append(3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(1u, sut->durableSequence());
+    EXPECT_EQ(RECORD_SIZE, fileSize());
+
+    setrlimit(RLIMIT_FSIZE, &original);
+    EXPECT_TRUE(waitDurable(3));
+    sut.reset();
+    EXPECT_EQ((std::vector<uint64_t>{1, 2, 3}), replay());
+}
+
+TEST_F(JournalTest, shouldFailWhenBatchCannotBeCutOff)
+{
+    // Note: Writes to /dev/full fail with ENOSPC and it can't be truncated either.
+    sut = std::make_unique<Journal>("/dev/full", std::chrono::milliseconds(1), 1024*1024);
+    append(1);
+    for (int i = 0; i < 5000 && !sut->failed(); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(sut->failed());
+    append(2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(0u, sut->durableSequence());
+}
@@ -0,0 +1,68 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Pattern.hpp>
+
+using namespace testing;
+using namespace propertytree;
+
+// matches: pPattern against pPath, both split on '/'
+static bool matches(const std::string& pPattern, const std::string& pPath)
+{
+    auto split = [](std::string_view pString) {
+            std::vector<std::string_view> rv;
+            while (pString.size())
+            {
+                auto end = pString.find('/');
+                rv.emplace_back(pString.substr(0, end));
+                pString = std::string_view::npos == end ? std::string_view{} : pString.substr(end + 1);
+            }
+            return rv;
+        };
+
+    auto pattern = split(pPattern);
+    auto path = split(pPath);
+    return matchPath(pattern, 0, [&path](size_t pIndex) { return path[pIndex]; }, 0, path.size());
+}
+
+TEST(PatternTest, shouldMatchGlob)
+{
+    EXPECT_TRUE(matchGlob("", "anything"));
+    EXPECT_TRUE(matchGlob("temp", "temp"));
+    EXPECT_FALSE(matchGlob("temp", "temp0"));
+    EXPECT_FALSE(matchGlob("temp0", "temp"));
+    EXPECT_TRUE(matchGlob("temp?", "temp0"));
+    EXPECT_FALSE(matchGlob("temp?", "temp"));
+    EXPECT_TRUE(matchGlob("*", ""));
+    EXPECT_TRUE(matchGlob("t*p", "tp"));
+    EXPECT_TRUE(matchGlob("*_a", "temp_b_a"));
+    EXPECT_FALSE(matchGlob("*_a", "temp_a_b"));
+    EXPECT_TRUE(matchGlob("*a*b*c", "xaybzaxbc"));
+    EXPECT_FALSE(matchGlob("*a*b*c", "xaybzaxcb"));
+    EXPECT_TRUE(matchGlob("a**", "a"));
+}
+
+TEST(PatternTest, shouldMatchPathBySegment)
+{
+    EXPECT_TRUE(matches("rack/unit*/temp", "rack/unit0/temp"));
+    EXPECT_FALSE(matches("rack/unit*/temp", "rack/unit0/temp/raw"));
+    EXPECT_FALSE(matches("rack/unit*/temp", "rack/unit0"));
+    EXPECT_FALSE(matches("unit?/fan/*", "unit0/fan"));
+    EXPECT_TRUE(matches("unit?/fan/*", "unit0/fan/speed"));
+}
+
+TEST(PatternTest, shouldMatchAnyNumberOfSegmentsWithDoubleStar)
+{
+    EXPECT_TRUE(matches("**", "a"));
+    EXPECT_TRUE(matches("**/fan", "fan"));
+    EXPECT_TRUE(matches("**/fan", "rack/unit0/fan"));
+    EXPECT_FALSE(matches("**/fan", "rack/unit0/fan/speed"));
+    EXPECT_TRUE(matches("rack/**/temp", "rack/temp"));
+
+    // Note: The first place "**" could stop at leads nowhere, it has to backtrack.
+    EXPECT_TRUE(matches("**/a/b", "a/x/a/b"));
+    EXPECT_TRUE(matches("**/a/**/b", "a/b/a/c/b"));
+    EXPECT_FALSE(matches("**/a/**/b", "b/a/c"));
+}
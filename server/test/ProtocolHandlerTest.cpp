@@ -0,0 +1,869 @@
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ProtocolHandler.hpp>
+
+using namespace testing;
+using namespace propertytree;
+
+struct ConnectionSessionMock : IConnectionSession
+{
+    void send(const bfc::ConstBufferView& pData, Lane) override
+    {
+        // Note: Frames start with their uint16_t size.
+        PropertyTreeProtocol message;
+        cum::per_codec_ctx context((std::byte*)pData.data() + sizeof(uint16_t), pData.size() - sizeof(uint16_t));
+        decode_per(message, context);
+        frameSizes.emplace_back(pData.size());
+
+        if (auto single = std::get_if<PropertyTreeMessage>(&message))
+        {
+            messages.emplace_back(std::move(*single));
+            return;
+        }
+        for (auto& i : std::get<PropertyTreeMessageArray>(message))
+        {
+            messages.emplace_back(std::move(i));
+        }
+    }
+
+    void disconnect() override
+    {
+        disconnected = true;
+    }
+
+    // take: removes and returns the received messages of type T, oldest first
+    template <typename T>
+    std::vector<T> take()
+    {
+        std::vector<T> rv;
+        for (auto i = messages.begin(); messages.end() != i;)
+        {
+            if (auto message = std::get_if<T>(&i->message))
+            {
+                rv.emplace_back(std::move(*message));
+                i = messages.erase(i);
+                continue;
+            }
+            i++;
+        }
+        return rv;
+    }
+
+    std::vector<PropertyTreeMessage> messages;
+    std::vector<size_t> frameSizes;
+    bool disconnected = false;
+};
+
+struct ProtocolHandlerTest : Test
+{
+    void start()
+    {
+        sut = std::make_unique<ProtocolHandler>([](){}, config);
+    }
+
+    template <typename T>
+    void request(const std::shared_ptr<ConnectionSessionMock>& pConnection, T&& pMsg, uint16_t pTransactionId = 1)
+    {
+        PropertyTreeProtocol message = PropertyTreeMessage{};
+        auto& propertyTreeMessage = std::get<PropertyTreeMessage>(message);
+        propertyTreeMessage.transactionId = pTransactionId;
+        propertyTreeMessage.message = std::forward<T>(pMsg);
+
+        std::byte buffer[1024*64];
+        cum::per_codec_ctx context(buffer, sizeof(buffer));
+        encode_per(message, context);
+        sut->onMsg(bfc::ConstBufferView(buffer, sizeof(buffer) - context.size()), pConnection);
+    }
+
+    // response: takes the single message of type T the connection must have received
+    template <typename T>
+    T response(const std::shared_ptr<ConnectionSessionMock>& pConnection)
+    {
+        auto received = pConnection->take<T>();
+        EXPECT_EQ(1u, received.size());
+        return received.size() ? std::move(received.back()) : T{};
+    }
+
+    std::shared_ptr<ConnectionSessionMock> signin()
+    {
+        auto connection = std::make_shared<ConnectionSessionMock>();
+        request(connection, SigninRequest{});
+        auto signinAccept = response<SigninAccept>(connection);
+        tokens[connection.get()] = signinAccept.token;
+        return connection;
+    }
+
+    uint64_t create(const std::shared_ptr<ConnectionSessionMock>& pConnection, const std::string& pName, uint64_t pParentUuid = 0,
+        bool pEphemeral = false, ValueType pType = ValueType::NONE)
+    {
+        request(pConnection, CreateRequest{pName, pParentUuid, pEphemeral, pType});
+        auto createAccept = pConnection->take<CreateAccept>();
+        // Note: With a journal, the accept waits for the record to be durable.
+        if (createAccept.empty() && config.journalPath.size() && !pEphemeral)
+        {
+            waitFor([&](){
+                    createAccept = pConnection->take<CreateAccept>();
+                    return !createAccept.empty();
+                });
+        }
+        return createAccept.size() ? createAccept.back().uuid : 0;
+    }
+
+    void set(const std::shared_ptr<ConnectionSessionMock>& pConnection, uint64_t pUuid, Buffer pData)
+    {
+        request(pConnection, SetValueRequest{pUuid, std::move(pData)});
+        if (pConnection->take<SetValueAccept>().empty() && config.journalPath.size())
+        {
+            waitFor([&](){ return !pConnection->take<SetValueAccept>().empty(); });
+        }
+    }
+
+    // tree: recursive listing of pUuid as path to value
+    std::map<std::string, Buffer> tree(const std::shared_ptr<ConnectionSessionMock>& pConnection, uint64_t pUuid = 0)
+    {
+        std::map<uint64_t, std::string> paths{{pUuid, ""}};
+        std::map<std::string, Buffer> rv;
+        uint64_t continuation = 0;
+        do
+        {
+            request(pConnection, TreeInfoRequest{pUuid, ".", true, continuation, true});
+            auto treeInfoResponse = response<TreeInfoResponse>(pConnection);
+            for (auto i = 0u; i < treeInfoResponse.nodeToAddList.size(); i++)
+            {
+                auto& node = treeInfoResponse.nodeToAddList[i];
+                auto& path = paths[node.uuid] = paths[node.parentUuid] + "/" + node.name;
+                rv[path] = treeInfoResponse.values[i].data;
+            }
+            continuation = treeInfoResponse.continuation;
+        } while (continuation);
+        return rv;
+    }
+
+    // load: registers the connection for the tree changes under pUuid
+    void load(const std::shared_ptr<ConnectionSessionMock>& pConnection, uint64_t pUuid, bool pRecursive = false)
+    {
+        request(pConnection, TreeInfoRequest{pUuid, ".", pRecursive, 0, false});
+        pConnection->take<TreeInfoResponse>();
+    }
+
+    // temporary: path of a scratch file removed after the test
+    std::string temporary(const std::string& pName)
+    {
+        auto path = std::string("/tmp/ProtocolHandlerTest.") + std::to_string(getpid()) + "." + pName;
+        temporaries.emplace_back(path);
+        return path;
+    }
+
+    ~ProtocolHandlerTest()
+    {
+        sut.reset();
+        for (auto& i : temporaries)
+        {
+            unlink(i.c_str());
+        }
+    }
+
+    // waitFor: ticks until pCondition holds, false after a few seconds
+    template <typename T>
+    bool waitFor(T&& pCondition)
+    {
+        for (int i = 0; i < 5000; i++)
+        {
+            sut->onTick();
+            if (pCondition())
+            {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+    ServerConfig config;
+    std::unique_ptr<ProtocolHandler> sut;
+    std::vector<std::string> temporaries;
+    std::map<ConnectionSessionMock*, uint64_t> tokens;
+};
+
+TEST_F(ProtocolHandlerTest, shouldCoalesceTreeChangesUntilTick)
+{
+    start();
+    auto creator = signin();
+    auto observer = signin();
+    load(observer, 0);
+
+    auto a = create(creator, "a");
+    auto b = create(creator, "b");
+    auto transient = create(creator, "transient");
+    request(creator, DeleteRequest{transient, false});
+
+    EXPECT_TRUE(observer->take<TreeUpdateNotification>().empty());
+    sut->onTick();
+
+    auto notifications = observer->take<TreeUpdateNotification>();
+    ASSERT_EQ(1u, notifications.size());
+    auto& added = notifications[0].nodeToAddList;
+    ASSERT_EQ(2u, added.size());
+    EXPECT_EQ(a, added[0].uuid);
+    EXPECT_EQ(b, added[1].uuid);
+    EXPECT_TRUE(notifications[0].nodeToDelete.empty());
+
+    // Note: The creator learned its nodes from CreateAccept, it is only told about the delete.
+    notifications = creator->take<TreeUpdateNotification>();
+    ASSERT_EQ(1u, notifications.size());
+    EXPECT_TRUE(notifications[0].nodeToAddList.empty());
+    EXPECT_EQ(u64Array{transient}, notifications[0].nodeToDelete);
+
+    sut->onTick();
+    EXPECT_TRUE(observer->take<TreeUpdateNotification>().empty());
+}
+
+TEST_F(ProtocolHandlerTest, shouldNotFlushEarlyForCancelledTreeChanges)
+{
+    start();
+    auto creator = signin();
+    auto observer = signin();
+    load(observer, 0);
+
+    // Note: Each create cancelled by its delete must give back exactly the size it queued, any
+    //       leftover adds up until a partial flush goes out before the tick.
+    for (int i = 0; i < 40000; i++)
+    {
+        auto uuid = create(creator, "x");
+        request(creator, DeleteRequest{uuid, false});
+        creator->messages.clear();
+    }
+    auto kept = create(creator, "kept");
+    EXPECT_TRUE(observer->take<TreeUpdateNotification>().empty());
+
+    sut->onTick();
+    auto notifications = observer->take<TreeUpdateNotification>();
+    ASSERT_EQ(1u, notifications.size());
+    ASSERT_EQ(1u, notifications[0].nodeToAddList.size());
+    EXPECT_EQ(kept, notifications[0].nodeToAddList[0].uuid);
+    EXPECT_TRUE(notifications[0].nodeToDelete.empty());
+}
+
+TEST_F(ProtocolHandlerTest, shouldPageTreeInfoByEncodedSize)
+{
+    start();
+    auto connection = signin();
+    std::set<uint64_t> created;
+    for (auto name : {"a", "b", "c", "d", "e"})
+    {
+        auto uuid = create(connection, name);
+        set(connection, uuid, Buffer(30*1024, 'x'));
+        created.emplace(uuid);
+    }
+
+    std::set<uint64_t> received;
+    uint64_t continuation = 0;
+    do
+    {
+        connection->frameSizes.clear();
+        request(connection, TreeInfoRequest{0, ".", false, continuation, true});
+        auto treeInfoResponse = response<TreeInfoResponse>(connection);
+        ASSERT_EQ(1u, connection->frameSizes.size());
+        EXPECT_GE(1024*48u + sizeof(uint16_t), connection->frameSizes[0]);
+        ASSERT_FALSE(treeInfoResponse.nodeToAddList.empty());
+        ASSERT_EQ(treeInfoResponse.nodeToAddList.size(), treeInfoResponse.values.size());
+        for (auto& i : treeInfoResponse.nodeToAddList)
+        {
+            received.emplace(i.uuid);
+        }
+        continuation = treeInfoResponse.continuation;
+    } while (continuation);
+
+    EXPECT_EQ(created, received);
+}
+
+TEST_F(ProtocolHandlerTest, shouldRejectValueThatCannotFitInPage)
+{
+    start();
+    auto connection = signin();
+    auto uuid = create(connection, "large");
+
+    request(connection, SetValueRequest{uuid, Buffer(40*1024, 'x')});
+    EXPECT_EQ(Cause::TOO_LARGE, response<SetValueReject>(connection).cause);
+
+    request(connection, CreateRequest{std::string(40*1024, 'n'), 0, false, ValueType::NONE});
+    EXPECT_EQ(Cause::TOO_LARGE, response<CreateReject>(connection).cause);
+}
+
+TEST_F(ProtocolHandlerTest, shouldResumeTreeInfoAfterSiblingsOfContinuationRemoved)
+{
+    start();
+    auto connection = signin();
+    std::map<std::string, uint64_t> uuids;
+    for (auto name : {"a", "b", "c", "d", "e"})
+    {
+        uuids[name] = create(connection, name);
+        // Note: Large values so that every page holds a single node.
+        set(connection, uuids[name], Buffer(30*1024, 'x'));
+    }
+
+    request(connection, TreeInfoRequest{0, ".", false, 0, true});
+    auto treeInfoResponse = response<TreeInfoResponse>(connection);
+    ASSERT_EQ(1u, treeInfoResponse.nodeToAddList.size());
+    EXPECT_EQ(uuids["a"], treeInfoResponse.nodeToAddList[0].uuid);
+    ASSERT_EQ(uuids["b"], treeInfoResponse.continuation);
+
+    // Note: Remove a sibling already received and one not yet received.
+    request(connection, DeleteRequest{uuids["a"], false});
+    request(connection, DeleteRequest{uuids["c"], false});
+
+    std::vector<std::string> received;
+    auto continuation = treeInfoResponse.continuation;
+    while (continuation)
+    {
+        request(connection, TreeInfoRequest{0, ".", false, continuation, true});
+        treeInfoResponse = response<TreeInfoResponse>(connection);
+        for (auto& i : treeInfoResponse.nodeToAddList)
+        {
+            received.emplace_back(i.name);
+        }
+        continuation = treeInfoResponse.continuation;
+    }
+
+    EXPECT_EQ((std::vector<std::string>{"b", "d", "e"}), received);
+}
+
+TEST_F(ProtocolHandlerTest, shouldRejectTreeInfoContinuationRemoved)
+{
+    start();
+    auto connection = signin();
+    std::map<std::string, uint64_t> uuids;
+    for (auto name : {"a", "b"})
+    {
+        uuids[name] = create(connection, name);
+        set(connection, uuids[name], Buffer(30*1024, 'x'));
+    }
+
+    request(connection, TreeInfoRequest{0, ".", false, 0, true});
+    auto continuation = response<TreeInfoResponse>(connection).continuation;
+    ASSERT_EQ(uuids["b"], continuation);
+
+    request(connection, DeleteRequest{uuids["b"], false});
+    request(connection, TreeInfoRequest{0, ".", false, continuation, true});
+    EXPECT_EQ(Cause::NOT_FOUND, response<TreeInfoErrorResponse>(connection).cause);
+}
+
+TEST_F(ProtocolHandlerTest, shouldRestoreSnapshotAndJournalOnStartup)
+{
+    config.snapshotPath = temporary("snapshot");
+    config.journalPath = temporary("journal");
+    auto rotatedJournal = temporary("journal.old");
+    config.snapshotPeriod = std::chrono::seconds(1);
+    config.journalSyncPeriod = std::chrono::milliseconds(1);
+    start();
+
+    auto connection = signin();
+    auto a = create(connection, "a");
+    auto b = create(connection, "b", a);
+    set(connection, a, Buffer{'1'});
+    set(connection, b, Buffer{'2'});
+    create(connection, "ephemeral", 0, true);
+
+    // Note: The snapshot is written by a child process, the covered journal is rotated then released.
+    ASSERT_TRUE(waitFor([&](){
+            struct stat journalStat;
+            return 0 == access(config.snapshotPath.c_str(), F_OK) && -1 == access(rotatedJournal.c_str(), F_OK) &&
+                0 == stat(config.journalPath.c_str(), &journalStat) && 0 == journalStat.st_size;
+        }));
+
+    // Note: Changes after the snapshot only live in the journal.
+    auto c = create(connection, "c");
+    set(connection, c, Buffer{'3'});
+    set(connection, a, Buffer{'4'});
+    request(connection, DeleteRequest{b, false});
+    auto before = tree(connection);
+    sut.reset();
+
+    start();
+    connection = signin();
+    auto after = tree(connection);
+    EXPECT_EQ(before.size() - 1, after.size());
+    EXPECT_EQ(0u, after.count("/ephemeral"));
+    EXPECT_EQ((Buffer{'4'}), after["/a"]);
+    EXPECT_EQ((Buffer{'3'}), after["/c"]);
+    EXPECT_EQ(0u, after.count("/a/b"));
+
+    // Note: Restored nodes keep their uuids, new ones don't collide with them.
+    EXPECT_NE(c, create(connection, "d"));
+}
+
+TEST_F(ProtocolHandlerTest, shouldReplayJournalOnTopOfSnapshot)
+{
+    config.snapshotPath = temporary("snapshot");
+    config.journalPath = temporary("journal");
+    temporary("journal.old");
+    config.snapshotPeriod = {};
+    config.journalSyncPeriod = std::chrono::milliseconds(1);
+    start();
+
+    auto connection = signin();
+    auto first = create(connection, "x");
+    set(connection, first, Buffer{'1'});
+    request(connection, DeleteRequest{first, false});
+    auto second = create(connection, "x");
+    set(connection, second, Buffer{'2'});
+
+    // Note: The final snapshot on terminate leaves the journal it covers in place.
+    uint32_t terminate = 9;
+    request(connection, SetValueRequest{0, Buffer((uint8_t*)&terminate, (uint8_t*)&terminate + sizeof(terminate))});
+    auto y = create(connection, "y");
+    set(connection, y, Buffer{'3'});
+    sut.reset();
+
+    start();
+    connection = signin();
+    EXPECT_EQ((std::map<std::string, Buffer>{{"/x", {'2'}}, {"/y", {'3'}}}), tree(connection));
+}
+
+TEST_F(ProtocolHandlerTest, shouldReleaseAcksWhenJournalFails)
+{
+    config.journalPath = "/dev/full";
+    config.journalSyncPeriod = std::chrono::milliseconds(1);
+    start();
+    auto connection = signin();
+
+    // Note: The first accept waits until the failure is seen, later ones aren't held anymore.
+    EXPECT_NE(0u, create(connection, "first"));
+    request(connection, CreateRequest{"second", 0, false, ValueType::NONE});
+    EXPECT_EQ(1u, connection->take<CreateAccept>().size());
+    EXPECT_EQ((std::map<std::string, Buffer>{{"/first", {}}, {"/second", {}}}), tree(connection));
+}
+
+TEST_F(ProtocolHandlerTest, shouldLoadMappedSnapshotLazily)
+{
+    config.snapshotPath = temporary("snapshot");
+    config.snapshotPeriod = {};
+    config.snapshotMapped = true;
+    start();
+
+    auto connection = signin();
+    auto a = create(connection, "a");
+    auto b = create(connection, "b", a, false, ValueType::U8);
+    auto c = create(connection, "c", b);
+    create(connection, "d");
+    set(connection, b, Buffer{7});
+    set(connection, c, Buffer{'c'});
+    auto before = tree(connection);
+
+    uint32_t terminate = 9;
+    request(connection, SetValueRequest{0, Buffer((uint8_t*)&terminate, (uint8_t*)&terminate + sizeof(terminate))});
+    sut.reset();
+
+    start();
+    connection = signin();
+
+    // Note: A deep node is found through the image, its ancestors are materialized on the way.
+    request(connection, GetRequest{c});
+    auto getAccept = response<GetAccept>(connection);
+    EXPECT_EQ(Buffer{'c'}, getAccept.data);
+    EXPECT_EQ(1u, getAccept.version);
+
+    request(connection, SetValueRequest{b, Buffer{1, 2}});
+    EXPECT_EQ(Cause::TYPE_MISMATCH, response<SetValueReject>(connection).cause);
+
+    EXPECT_EQ(before, tree(connection));
+}
+
+TEST_F(ProtocolHandlerTest, shouldSnapshotUnloadedSubtreesFromImage)
+{
+    config.snapshotPath = temporary("snapshot");
+    config.snapshotPeriod = {};
+    config.snapshotMapped = true;
+    start();
+
+    auto connection = signin();
+    auto a = create(connection, "a");
+    auto b = create(connection, "b", a);
+    auto x = create(connection, "x");
+    auto y = create(connection, "y", x, false, ValueType::U8);
+    create(connection, "z", y);
+    set(connection, b, Buffer{'b'});
+    set(connection, y, Buffer{7});
+
+    uint32_t terminate = 9;
+    request(connection, SetValueRequest{0, Buffer((uint8_t*)&terminate, (uint8_t*)&terminate + sizeof(terminate))});
+    sut.reset();
+
+    // Note: Only /a is materialized before the next snapshot, /x goes from image to image.
+    start();
+    connection = signin();
+    set(connection, b, Buffer{'c'});
+    create(connection, "e", a, true);
+    request(connection, SetValueRequest{0, Buffer((uint8_t*)&terminate, (uint8_t*)&terminate + sizeof(terminate))});
+    sut.reset();
+
+    start();
+    connection = signin();
+    request(connection, GetRequest{y});
+    auto getAccept = response<GetAccept>(connection);
+    EXPECT_EQ(Buffer{7}, getAccept.data);
+    EXPECT_EQ(1u, getAccept.version);
+
+    request(connection, SetValueRequest{y, Buffer{1, 2}});
+    EXPECT_EQ(Cause::TYPE_MISMATCH, response<SetValueReject>(connection).cause);
+
+    EXPECT_EQ((std::map<std::string, Buffer>{{"/a", {}}, {"/a/b", {'c'}}, {"/x", {}}, {"/x/y", {7}}, {"/x/y/z", {}}}),
+        tree(connection));
+}
+
+TEST_F(ProtocolHandlerTest, shouldResumeAfterPartialTreeUpdateWithoutLosingChanges)
+{
+    start();
+    auto creator = signin();
+    auto observer = signin();
+    load(observer, 0);
+
+    // Note: Enough nodes in one change that the observer's queue is flushed before it is complete.
+    BulkCreateRequest bulkCreateRequest{0, {}};
+    for (int i = 0; i < 400; i++)
+    {
+        bulkCreateRequest.nodes.push_back(TemplateNode{std::string(100, 'n') + std::to_string(i), 0xFFFFFFFF, {}, ValueType::NONE});
+    }
+    request(creator, std::move(bulkCreateRequest));
+    auto created = response<BulkCreateAccept>(creator).uuids;
+    ASSERT_EQ(400u, created.size());
+
+    std::set<uint64_t> added;
+    uint64_t sequence = 0;
+    auto partial = observer->take<TreeUpdateNotification>();
+    ASSERT_FALSE(partial.empty());
+    for (auto& i : partial)
+    {
+        sequence = std::max(sequence, i.sequence);
+        for (auto& j : i.nodeToAddList)
+        {
+            added.emplace(j.uuid);
+        }
+    }
+    ASSERT_GT(400u, added.size());
+
+    // Note: The connection is lost before the tick that would have sent the rest.
+    sut->onDisconnect(observer.get());
+    auto resumed = std::make_shared<ConnectionSessionMock>();
+    request(resumed, ResumeRequest{tokens[observer.get()], sequence});
+    response<ResumeAccept>(resumed);
+    for (auto& i : resumed->take<TreeUpdateNotification>())
+    {
+        for (auto& j : i.nodeToAddList)
+        {
+            added.emplace(j.uuid);
+        }
+    }
+
+    EXPECT_EQ(std::set<uint64_t>(created.begin(), created.end()), added);
+}
+
+TEST_F(ProtocolHandlerTest, shouldRejectResumeOfUnknownSession)
+{
+    start();
+    auto connection = std::make_shared<ConnectionSessionMock>();
+    request(connection, ResumeRequest{12345, 0});
+    EXPECT_EQ(Cause::NOT_FOUND, response<ResumeReject>(connection).cause);
+}
+
+TEST_F(ProtocolHandlerTest, shouldRejectResumeBelowChangeLogFloor)
+{
+    config.changeLogSize = 4;
+    start();
+    auto creator = signin();
+    auto observer = std::make_shared<ConnectionSessionMock>();
+    request(observer, SigninRequest{});
+    auto signinAccept = response<SigninAccept>(observer);
+    sut->onDisconnect(observer.get());
+
+    for (int i = 0; i < 8; i++)
+    {
+        create(creator, "n" + std::to_string(i));
+    }
+
+    auto resumed = std::make_shared<ConnectionSessionMock>();
+    request(resumed, ResumeRequest{signinAccept.token, signinAccept.sequence});
+    EXPECT_EQ(Cause::EXPIRED, response<ResumeReject>(resumed).cause);
+}
+
+TEST_F(ProtocolHandlerTest, shouldRestoreSubscriptionsOnResume)
+{
+    start();
+    auto creator = signin();
+    auto subscriber = signin();
+    auto uuid = create(creator, "value");
+    request(subscriber, SubscribeRequest{uuid});
+    response<SubscribeResponse>(subscriber);
+
+    // Note: The server drops the connection object along with the socket.
+    auto token = tokens[subscriber.get()];
+    sut->onDisconnect(subscriber.get());
+    subscriber.reset();
+    set(creator, uuid, Buffer{1});
+
+    auto resumed = std::make_shared<ConnectionSessionMock>();
+    request(resumed, ResumeRequest{token, 0});
+    auto resumeAccept = response<ResumeAccept>(resumed);
+
+    // Note: The value missed while disconnected is replayed, later ones go to the new connection.
+    auto replayed = resumed->take<UpdateNotification>();
+    ASSERT_EQ(1u, replayed.size());
+    EXPECT_EQ(Buffer{1}, replayed[0].data);
+
+    set(creator, uuid, Buffer{2});
+    auto updated = resumed->take<UpdateNotification>();
+    ASSERT_EQ(1u, updated.size());
+    EXPECT_EQ(Buffer{2}, updated[0].data);
+    EXPECT_LT(resumeAccept.sequence, updated[0].sequence);
+}
+
+TEST_F(ProtocolHandlerTest, shouldTearDownSessionAfterGracePeriod)
+{
+    config.sessionGracePeriod = std::chrono::seconds(0);
+    start();
+    auto creator = signin();
+    auto subscriber = signin();
+    auto uuid = create(creator, "value");
+    create(subscriber, "ephemeral", 0, true);
+    request(subscriber, SubscribeRequest{uuid});
+    response<SubscribeResponse>(subscriber);
+
+    auto token = tokens[subscriber.get()];
+    sut->onDisconnect(subscriber.get());
+    subscriber.reset();
+    sut->onTick();
+
+    EXPECT_LT(0u, sut->reclaimedSize());
+    EXPECT_EQ((std::map<std::string, Buffer>{{"/value", {}}}), tree(creator));
+    set(creator, uuid, Buffer{1});
+
+    auto resumed = std::make_shared<ConnectionSessionMock>();
+    request(resumed, ResumeRequest{token, 0});
+    EXPECT_EQ(Cause::NOT_FOUND, response<ResumeReject>(resumed).cause);
+}
+
+TEST_F(ProtocolHandlerTest, shouldKeepSessionResumedWithinGracePeriod)
+{
+    config.sessionGracePeriod = std::chrono::seconds(1);
+    start();
+    auto creator = signin();
+    auto subscriber = signin();
+    auto uuid = create(creator, "value");
+    request(subscriber, SubscribeRequest{uuid});
+    response<SubscribeResponse>(subscriber);
+    auto token = tokens[subscriber.get()];
+
+    // Note: The entry of the first disconnection runs out while the session is disconnected again,
+    //       only the second one may tear it down.
+    sut->onDisconnect(subscriber.get());
+    subscriber = std::make_shared<ConnectionSessionMock>();
+    request(subscriber, ResumeRequest{token, 0});
+    response<ResumeAccept>(subscriber);
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    sut->onDisconnect(subscriber.get());
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    sut->onTick();
+    EXPECT_EQ(0u, sut->reclaimedSize());
+
+    subscriber = std::make_shared<ConnectionSessionMock>();
+    request(subscriber, ResumeRequest{token, 0});
+    response<ResumeAccept>(subscriber);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    sut->onTick();
+    EXPECT_EQ(0u, sut->reclaimedSize());
+
+    set(creator, uuid, Buffer{1});
+    EXPECT_EQ(1u, subscriber->take<UpdateNotification>().size());
+}
+
+TEST_F(ProtocolHandlerTest, shouldEstimateReclaimedSizeBySubscriptions)
+{
+    config.sessionGracePeriod = std::chrono::seconds(0);
+    start();
+    auto creator = signin();
+    std::vector<uint64_t> uuids;
+    for (int i = 0; i < 100; i++)
+    {
+        uuids.emplace_back(create(creator, "n" + std::to_string(i)));
+    }
+
+    auto idle = signin();
+    sut->onDisconnect(idle.get());
+    sut->onTick();
+    auto idleSize = sut->reclaimedSize();
+
+    auto subscriber = signin();
+    for (auto uuid : uuids)
+    {
+        request(subscriber, SubscribeRequest{uuid});
+    }
+    sut->onDisconnect(subscriber.get());
+    sut->onTick();
+    auto subscriberSize = sut->reclaimedSize() - idleSize;
+
+    // Note: Each subscription holds at least its uuid in the session and the session id in the node.
+    EXPECT_LE(idleSize + uuids.size() * (sizeof(uint64_t) + sizeof(uint32_t)), subscriberSize);
+}
+
+TEST_F(ProtocolHandlerTest, shouldRemoveEphemeralsInOneTreeUpdateAtTeardown)
+{
+    config.sessionGracePeriod = std::chrono::seconds(0);
+    start();
+    auto owner = signin();
+    auto observer = signin();
+    load(observer, 0);
+
+    create(owner, "durable");
+    std::set<uint64_t> ephemerals;
+    for (auto name : {"e0", "e1", "e2"})
+    {
+        ephemerals.emplace(create(owner, name, 0, true));
+    }
+    sut->onTick();
+    observer->take<TreeUpdateNotification>();
+
+    // Note: The ephemerals outlive the connection, they go when the session is torn down after
+    //       its grace period.
+    sut->onDisconnect(owner.get());
+    owner.reset();
+    EXPECT_TRUE(observer->take<TreeUpdateNotification>().empty());
+    sut->onTick();
+    sut->onTick();
+
+    auto notifications = observer->take<TreeUpdateNotification>();
+    ASSERT_EQ(1u, notifications.size());
+    EXPECT_TRUE(notifications[0].nodeToAddList.empty());
+    auto& deleted = notifications[0].nodeToDelete;
+    EXPECT_EQ(ephemerals, std::set<uint64_t>(deleted.begin(), deleted.end()));
+    EXPECT_EQ((std::map<std::string, Buffer>{{"/durable", {}}}), tree(observer));
+}
+
+TEST_F(ProtocolHandlerTest, shouldRemoveAggregateWithItsSource)
+{
+    start();
+    auto creator = signin();
+    auto observer = signin();
+    auto sensors = create(creator, "sensors");
+    auto temp = create(creator, "temp", sensors, false, ValueType::I32);
+    set(creator, temp, Buffer{1, 0, 0, 0});
+
+    request(creator, AggregateCreateRequest{"sum", 0, sensors, "", AggregateFunction::SUM});
+    auto sum = response<CreateAccept>(creator).uuid;
+    load(observer, 0);
+    request(observer, SubscribeRequest{sum});
+    response<SubscribeResponse>(observer);
+    sut->onTick();
+    observer->take<TreeUpdateNotification>();
+
+    request(creator, DeleteRequest{sensors, true});
+    response<DeleteResponse>(creator);
+    sut->onTick();
+
+    auto notifications = observer->take<TreeUpdateNotification>();
+    ASSERT_EQ(1u, notifications.size());
+    auto& deleted = notifications[0].nodeToDelete;
+    EXPECT_EQ((std::set<uint64_t>{sensors, sum}), std::set<uint64_t>(deleted.begin(), deleted.end()));
+    EXPECT_TRUE(tree(observer).empty());
+
+    request(observer, GetRequest{sum});
+    EXPECT_EQ(Cause::NOT_FOUND, response<GetReject>(observer).cause);
+}
+
+TEST_F(ProtocolHandlerTest, shouldResumeRecursiveTreeInfoPastAncestorsOfContinuation)
+{
+    start();
+    auto connection = signin();
+    auto a = create(connection, "a");
+    auto b = create(connection, "b");
+    for (auto uuid : {a, create(connection, "a1", a), create(connection, "a2", a), b, create(connection, "b1", b)})
+    {
+        set(connection, uuid, Buffer(30*1024, 'x'));
+    }
+
+    std::vector<std::string> received;
+    uint64_t continuation = 0;
+    for (int page = 0; page < 10 && (!page || continuation); page++)
+    {
+        request(connection, TreeInfoRequest{0, ".", true, continuation, true});
+        auto treeInfoResponse = response<TreeInfoResponse>(connection);
+        for (auto& i : treeInfoResponse.nodeToAddList)
+        {
+            received.emplace_back(i.name);
+        }
+        continuation = treeInfoResponse.continuation;
+    }
+
+    EXPECT_EQ(0u, continuation);
+    EXPECT_EQ((std::vector<std::string>{"a", "a1", "a2", "b", "b1"}), received);
+}
+
+TEST_F(ProtocolHandlerTest, shouldQueryNestedPathsByPattern)
+{
+    start();
+    auto connection = signin();
+    auto rack = create(connection, "rack");
+    for (auto unit : {"unit0", "unit1"})
+    {
+        auto uuid = create(connection, unit, rack);
+        create(connection, "temp", uuid);
+        create(connection, "fan", uuid);
+    }
+    create(connection, "zone", rack);
+
+    request(connection, QueryRequest{rack, "unit*/temp", false, 0});
+    auto queryResponse = response<QueryResponse>(connection);
+    ASSERT_EQ(2u, queryResponse.matches.size());
+    EXPECT_EQ("unit0/temp", queryResponse.matches[0].path);
+    EXPECT_EQ("unit1/temp", queryResponse.matches[1].path);
+    EXPECT_EQ(0u, queryResponse.continuation);
+
+    request(connection, QueryRequest{0, "**/fan", false, 0});
+    queryResponse = response<QueryResponse>(connection);
+    ASSERT_EQ(2u, queryResponse.matches.size());
+    EXPECT_EQ("rack/unit0/fan", queryResponse.matches[0].path);
+    EXPECT_EQ("rack/unit1/fan", queryResponse.matches[1].path);
+}
+
+TEST_F(ProtocolHandlerTest, shouldPageQueryIncludingTheNextMatch)
+{
+    start();
+    auto connection = signin();
+    for (auto name : {"a", "b", "c"})
+    {
+        set(connection, create(connection, name), Buffer(30*1024, 'x'));
+    }
+
+    // Note: Two of the values would already exceed a page, each page takes one.
+    std::vector<std::string> received;
+    uint64_t continuation = 0;
+    for (int page = 0; page < 10 && (!page || continuation); page++)
+    {
+        request(connection, QueryRequest{0, "*", true, continuation});
+        auto queryResponse = response<QueryResponse>(connection);
+        ASSERT_EQ(1u, queryResponse.matches.size());
+        received.emplace_back(queryResponse.matches[0].path);
+        continuation = queryResponse.continuation;
+    }
+    EXPECT_EQ((std::vector<std::string>{"a", "b", "c"}), received);
+}
+
+TEST_F(ProtocolHandlerTest, shouldRoundIdleTimeoutUpToTick)
+{
+    config.tickPeriod = std::chrono::milliseconds(10);
+    config.idleTimeout = std::chrono::milliseconds(5);
+    start();
+    auto connection = signin();
+
+    for (int i = 0; i < 4 && !connection->disconnected; i++)
+    {
+        sut->onTick();
+    }
+    EXPECT_TRUE(connection->disconnected);
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <TimerWheel.hpp>
+
+using namespace testing;
+using namespace propertytree;
+
+struct TimerWheelTest : Test
+{
+    // advanceTo: advances up to pTick, records <Tick, Cookie> of every timer expired
+    void advanceTo(uint64_t pTick)
+    {
+        while (sut.now() < pTick)
+        {
+            sut.advance([this](uint64_t pCookie){
+                    expired.emplace_back(sut.now(), pCookie);
+                });
+        }
+    }
+
+    using Expiry = std::vector<std::pair<uint64_t, uint64_t>>;
+
+    TimerWheel sut;
+    Expiry expired;
+};
+
+TEST_F(TimerWheelTest, shouldExpireOnScheduledTick)
+{
+    sut.schedule(5, 1);
+    sut.schedule(1, 2);
+    sut.schedule(63, 3);
+    sut.schedule(0, 4);
+
+    advanceTo(100);
+
+    // Note: Timers due on the same tick expire in no particular order.
+    std::sort(expired.begin(), expired.end());
+    EXPECT_EQ((Expiry{{1, 2}, {1, 4}, {5, 1}, {63, 3}}), expired);
+}
+
+TEST_F(TimerWheelTest, shouldCascadeFromHigherLevels)
+{
+    advanceTo(10);
+    sut.schedule(64, 1);
+    sut.schedule(100, 2);
+    sut.schedule(4096 + 7, 3);
+    sut.schedule(300000, 4);
+
+    advanceTo(400000);
+
+    EXPECT_EQ((Expiry{{74, 1}, {110, 2}, {4096 + 17, 3}, {300010, 4}}), expired);
+}
+
+TEST_F(TimerWheelTest, shouldCancelTimer)
+{
+    sut.schedule(10, 1);
+    auto middle = sut.schedule(10, 2);
+    sut.schedule(10, 3);
+    auto cascading = sut.schedule(200, 4);
+    sut.cancel(middle);
+    sut.cancel(cascading);
+
+    advanceTo(300);
+
+    std::sort(expired.begin(), expired.end());
+    EXPECT_EQ((Expiry{{10, 1}, {10, 3}}), expired);
+}
+
+TEST_F(TimerWheelTest, shouldReuseCancelledTimer)
+{
+    auto first = sut.schedule(10, 1);
+    sut.cancel(first);
+    auto second = sut.schedule(20, 2);
+    EXPECT_EQ(first, second);
+
+    advanceTo(30);
+
+    EXPECT_EQ((Expiry{{20, 2}}), expired);
+}
+
+TEST_F(TimerWheelTest, shouldScheduleFromExpiry)
+{
+    sut.schedule(3, 1);
+    for (int i = 0; i < 3; i++)
+    {
+        sut.advance([this](uint64_t pCookie){
+                sut.schedule(3, pCookie + 1);
+            });
+    }
+    advanceTo(6);
+
+    EXPECT_EQ((Expiry{{6, 2}}), expired);
+}
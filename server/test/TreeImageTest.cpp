@@ -0,0 +1,104 @@
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <TreeImage.hpp>
+
+using namespace testing;
+using namespace propertytree;
+
+struct TreeImageTest : Test
+{
+    TreeImageTest()
+        : path(std::string("/tmp/TreeImageTest.") + std::to_string(getpid()))
+    {
+        // Note: Root "" with the children "a" and "b", "a" holding the value "1".
+        header = {TreeImage::MAGIC, 5, 3, 3, 2, 0, 0, 0};
+        header.nodesOffset = sizeof(header);
+        header.childrenOffset = header.nodesOffset + 3*sizeof(TreeImage::ImageNode);
+        header.blobOffset = header.childrenOffset + 2*sizeof(uint32_t);
+        nodes.push_back({0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0});
+        nodes.push_back({1, 0, 1, 0, 1, 1, 1, 2, 0, 0, 0});
+        nodes.push_back({2, 0, 0, 2, 3, 1, 0, 2, 0, 0, 0});
+        children = {1, 2};
+        blob = "a1b";
+    }
+
+    ~TreeImageTest()
+    {
+        unlink(path.c_str());
+    }
+
+    void write()
+    {
+        auto file = fopen(path.c_str(), "wb");
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(nodes.data(), sizeof(TreeImage::ImageNode), nodes.size(), file);
+        fwrite(children.data(), sizeof(uint32_t), children.size(), file);
+        fwrite(blob.data(), blob.size(), 1, file);
+        fclose(file);
+    }
+
+    std::string path;
+    TreeImage::ImageHeader header;
+    std::vector<TreeImage::ImageNode> nodes;
+    std::vector<uint32_t> children;
+    std::string blob;
+};
+
+TEST_F(TreeImageTest, shouldMapAndNavigateImage)
+{
+    write();
+    TreeImage sut(path);
+    EXPECT_EQ(5u, sut.header().sequence);
+
+    auto root = sut.find(0);
+    ASSERT_NE(nullptr, root);
+    ASSERT_TRUE(sut.valid(*root));
+    ASSERT_EQ(2u, root->childCount);
+
+    auto& a = sut.child(*root, 0);
+    ASSERT_TRUE(sut.valid(a));
+    EXPECT_EQ("a", sut.name(a));
+    EXPECT_EQ('1', *sut.data(a));
+    EXPECT_EQ("b", sut.name(sut.child(*root, 1)));
+    EXPECT_EQ(nullptr, sut.find(3));
+}
+
+TEST_F(TreeImageTest, shouldRejectNodeTableThatOverflows)
+{
+    header.nodeCount = (UINT64_MAX / sizeof(TreeImage::ImageNode)) + 1;
+    write();
+    EXPECT_THROW(TreeImage{path}, std::runtime_error);
+}
+
+TEST_F(TreeImageTest, shouldRejectTruncatedTables)
+{
+    header.childrenCount = 1024;
+    write();
+    EXPECT_THROW(TreeImage{path}, std::runtime_error);
+}
+
+TEST_F(TreeImageTest, shouldInvalidateNodesOutsideOfImage)
+{
+    nodes[0].childCount = 3;
+    nodes[1].dataOffset = UINT64_MAX;
+    nodes[2].nameSize = 1024;
+    write();
+    TreeImage sut(path);
+    EXPECT_FALSE(sut.valid(*sut.find(0)));
+    EXPECT_FALSE(sut.valid(*sut.find(1)));
+    EXPECT_FALSE(sut.valid(*sut.find(2)));
+}
+
+TEST_F(TreeImageTest, shouldInvalidateChildIndexOutsideOfNodeTable)
+{
+    children[1] = 3;
+    write();
+    TreeImage sut(path);
+    EXPECT_FALSE(sut.valid(*sut.find(0)));
+    EXPECT_TRUE(sut.valid(*sut.find(1)));
+}